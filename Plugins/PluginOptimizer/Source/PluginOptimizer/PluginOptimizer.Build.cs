@@ -32,7 +32,9 @@ public class PluginOptimizer : ModuleRules
             "Projects",        // IProjectManager
             "AssetRegistry",
             "ApplicationCore",
-            "AppFramework"
+            "AppFramework",
+            "Json",            // relatório do commandlet
+            "PluginOptimizerProfiler"   // perfil de startup (ordenação dos candidatos)
         });
 
         PrecompileForTargets = PrecompileTargetsType.Editor;
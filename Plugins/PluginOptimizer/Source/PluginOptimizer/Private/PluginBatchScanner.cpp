@@ -0,0 +1,204 @@
+#include "PluginBatchScanner.h"
+#include "PluginSourceScanner.h"
+
+#include "Interfaces/IPluginManager.h"
+#include "PluginDescriptor.h"
+#include "ProjectDescriptor.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Async/ParallelFor.h"
+
+FPluginBatchScanner::FPluginBatchScanner()
+{
+	check(IsInGameThread());
+
+	// engine (inclusive Marketplace): os do projeto aberto não valem para os outros
+	for (const TSharedRef<IPlugin>& P : IPluginManager::Get().GetDiscoveredPlugins())
+	{
+		if (P->GetLoadedFrom() != EPluginLoadedFrom::Engine)
+			continue;
+
+		const bool bDefault = P->GetDescriptor().EnabledByDefault == EPluginEnabledByDefault::Enabled;
+		MakeBatchPlugin(P->GetName(), P->GetBaseDir(), P->GetDescriptor(), bDefault, EnginePlugins.AddDefaulted_GetRef());
+	}
+}
+
+void FPluginBatchScanner::MakeBatchPlugin(const FString& Name, const FString& BaseDir, const FPluginDescriptor& Descriptor,
+	bool bEnabledByDefault, FBatchPlugin& Out)
+{
+	PluginScan::FScanPlugin& SP = Out.Snapshot;
+	SP.Name = Name;
+	SP.BaseDir = BaseDir;
+	if (Descriptor.bCanContainContent)
+		SP.MountPath = FString::Printf(TEXT("/%s/"), *Name);
+
+	PluginScan::CopyDescriptor(Descriptor, SP);
+
+	Out.bEnabledByDefault = bEnabledByDefault;
+}
+
+bool FPluginBatchScanner::GatherProjectPlugins(const FString& ProjectFile, TArray<PluginScan::FScanPlugin>& OutPlugins,
+	FString& OutError) const
+{
+	FProjectDescriptor Project;
+	FText Fail;
+	if (!Project.Load(ProjectFile, Fail))
+	{
+		OutError = Fail.ToString();
+		return false;
+	}
+
+	// disponíveis: engine + Plugins/ do projeto (o do projeto ganha em nome repetido)
+	TMap<FString, const FBatchPlugin*> Available;
+	for (const FBatchPlugin& P : EnginePlugins)
+		Available.Add(P.Snapshot.Name, &P);
+
+	TArray<FString> Descriptors;
+	IFileManager::Get().FindFilesRecursive(Descriptors, *FPaths::Combine(FPaths::GetPath(ProjectFile), TEXT("Plugins")),
+		TEXT("*.uplugin"), true, false);
+
+	TArray<FBatchPlugin> ProjectPlugins;
+	ProjectPlugins.Reserve(Descriptors.Num());
+	for (const FString& File : Descriptors)
+	{
+		FPluginDescriptor Descriptor;
+		if (!Descriptor.Load(File, Fail))
+			continue;
+
+		// plugin de projeto vem habilitado a não ser que o descritor diga o contrário
+		const bool bDefault = Descriptor.EnabledByDefault != EPluginEnabledByDefault::Disabled;
+		MakeBatchPlugin(FPaths::GetBaseFilename(File), FPaths::GetPath(File), Descriptor, bDefault,
+			ProjectPlugins.AddDefaulted_GetRef());
+	}
+	for (const FBatchPlugin& P : ProjectPlugins)
+		Available.Add(P.Snapshot.Name, &P);
+
+	TMap<FString, bool> Explicit;
+	for (const FPluginReferenceDescriptor& Ref : Project.Plugins)
+		Explicit.Add(Ref.Name, Ref.bEnabled);
+
+	// habilitados + fecho das dependências obrigatórias
+	TArray<const FBatchPlugin*> Pending;
+	TSet<FString> Enabled;
+	for (const TPair<FString, const FBatchPlugin*>& Pair : Available)
+	{
+		const bool* bExplicit = Explicit.Find(Pair.Key);
+		if (bExplicit ? *bExplicit : Pair.Value->bEnabledByDefault)
+		{
+			Enabled.Add(Pair.Key);
+			Pending.Add(Pair.Value);
+		}
+	}
+	while (Pending.Num())
+	{
+		const FBatchPlugin* P = Pending.Pop();
+		for (const FString& Dep : P->Snapshot.Dependencies)
+		{
+			const FBatchPlugin* const* DepPlugin = Available.Find(Dep);
+			if (DepPlugin && !Enabled.Contains(Dep))
+			{
+				Enabled.Add(Dep);
+				Pending.Add(*DepPlugin);
+			}
+		}
+	}
+
+	for (const TPair<FString, const FBatchPlugin*>& Pair : Available)
+	{
+		if (Enabled.Contains(Pair.Key))
+			OutPlugins.Add(Pair.Value->Snapshot);
+	}
+	OutPlugins.Sort([](const PluginScan::FScanPlugin& A, const PluginScan::FScanPlugin& B) { return A.Name < B.Name; });
+	return true;
+}
+
+FString FPluginBatchScanner::FindRegistry(const FString& ProjectFile)
+{
+	const FString CookedDir = FPaths::Combine(FPaths::GetPath(ProjectFile), TEXT("Saved"), TEXT("Cooked"));
+	const FString ProjectName = FPaths::GetBaseFilename(ProjectFile);
+
+	TArray<FString> Platforms;
+	IFileManager::Get().FindFiles(Platforms, *FPaths::Combine(CookedDir, TEXT("*")), false, true);
+
+	FString Best;
+	FDateTime BestTime = FDateTime::MinValue();
+	for (const FString& Platform : Platforms)
+	{
+		const FString Dir = FPaths::Combine(CookedDir, Platform, ProjectName);
+		for (const FString& Candidate : { FPaths::Combine(Dir, TEXT("Metadata"), TEXT("DevelopmentAssetRegistry.bin")),
+			FPaths::Combine(Dir, TEXT("AssetRegistry.bin")) })
+		{
+			const FDateTime Time = IFileManager::Get().GetTimeStamp(*Candidate);
+			if (Time != FDateTime::MinValue() && Time > BestTime)
+			{
+				Best = Candidate;
+				BestTime = Time;
+			}
+		}
+	}
+	return Best;
+}
+
+void FPluginBatchScanner::Run(TArray<FPluginBatchProject>& Projects, const FPluginScanOptions& Options, int32 MaxConcurrent) const
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(PluginScan_Batch);
+
+	// descoberta de plugins em série (lê .uplugin do disco, barato); o scan em paralelo
+	TArray<TArray<PluginScan::FScanPlugin>> PluginsPerProject;
+	PluginsPerProject.SetNum(Projects.Num());
+	for (int32 Idx = 0; Idx < Projects.Num(); ++Idx)
+	{
+		FPluginBatchProject& Project = Projects[Idx];
+		if (Project.RegistryPath.IsEmpty())
+			Project.RegistryPath = FindRegistry(Project.ProjectFile);
+
+		if (Project.RegistryPath.IsEmpty())
+			Project.Error = TEXT("No cooked asset registry found; pass one as <Project.uproject>,<AssetRegistry.bin>");
+		else
+			GatherProjectPlugins(Project.ProjectFile, PluginsPerProject[Idx], Project.Error);
+	}
+
+	// resolver e headers dos plugins do engine uma vez para o batch todo; cada
+	// projeto só acrescenta os seus por cima (ver BuildResolver com base)
+	PluginScan::FPluginBaseIndex Base;
+	Base.Plugins.Reserve(EnginePlugins.Num());
+	for (const FBatchPlugin& P : EnginePlugins)
+		Base.Plugins.Add(P.Snapshot);
+	PluginScan::BuildResolver(Base.Plugins, Base.Resolver);
+
+	if (Options.bScanSource)
+	{
+		// só o Source/ dos plugins do engine que algum projeto habilita
+		TSet<FString> EnabledSomewhere;
+		for (const TArray<PluginScan::FScanPlugin>& Plugins : PluginsPerProject)
+		{
+			for (const PluginScan::FScanPlugin& P : Plugins)
+				EnabledSomewhere.Add(P.BaseDir);
+		}
+
+		TBitArray<> Skip(true, Base.Plugins.Num());
+		for (int32 BaseIdx = 0; BaseIdx < Base.Plugins.Num(); ++BaseIdx)
+			Skip[BaseIdx] = !EnabledSomewhere.Contains(Base.Plugins[BaseIdx].BaseDir);
+		Base.Headers = PluginScan::BuildHeaderIndex(Base.Plugins, Skip, PluginScan::FScanContext());
+	}
+
+	// em ondas: cada projeto mantém o registry inteiro em memória durante o scan
+	const int32 Wave = FMath::Max(1, MaxConcurrent);
+	for (int32 First = 0; First < Projects.Num(); First += Wave)
+	{
+		ParallelFor(FMath::Min(Wave, Projects.Num() - First), [&](int32 Offset)
+			{
+				const int32 Idx = First + Offset;
+				FPluginBatchProject& Project = Projects[Idx];
+				if (!Project.Error.IsEmpty())
+					return;
+
+				FPluginScanOptions ProjectOptions = Options;
+				ProjectOptions.ProjectDir = FPaths::GetPath(Project.ProjectFile);
+				ProjectOptions.CachePath = FPaths::Combine(ProjectOptions.ProjectDir, TEXT("Saved"), TEXT("PluginOptimizer"), TEXT("ScanCache.bin"));
+
+				if (!PluginScan::RunRegistryFileScan(PluginsPerProject[Idx], Project.RegistryPath, ProjectOptions, Project.Result, &Base))
+					Project.Error = FString::Printf(TEXT("Could not read asset registry '%s'"), *Project.RegistryPath);
+			}, EParallelForFlags::Unbalanced);
+	}
+}
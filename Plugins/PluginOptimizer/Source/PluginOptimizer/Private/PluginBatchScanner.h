@@ -0,0 +1,53 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PluginScanCommon.h"
+
+struct FPluginDescriptor;
+
+/* Um projeto do batch e o resultado do seu scan */
+struct FPluginBatchProject
+{
+	FString ProjectFile;            // .uproject
+	FString RegistryPath;           // AssetRegistry.bin; vazio = FindRegistry
+	FPluginScanResult Result;
+	FString Error;                  // vazio = scan ok
+};
+
+/*
+ * Scan offline de vários projetos que compartilham o mesmo engine. Os plugins
+ * do engine (descritor, módulos, mount path) são coletados uma vez, e por Run
+ * o resolver e o índice de headers deles também; cada projeto só acrescenta os
+ * seus Plugins/ por cima e resolve o que o .uproject habilita.
+ * Cada projeto roda sobre o AssetRegistry.bin dele (ver RunRegistryFileScan).
+ */
+class FPluginBatchScanner
+{
+public:
+	// Snapshot dos plugins do engine (game thread)
+	FPluginBatchScanner();
+
+	// Projetos em paralelo, no máximo MaxConcurrent registries carregados por vez
+	void Run(TArray<FPluginBatchProject>& Projects, const FPluginScanOptions& Options, int32 MaxConcurrent) const;
+
+	// Saved/Cooked/<Plataforma>/<Projeto>/: DevelopmentAssetRegistry.bin ou
+	// AssetRegistry.bin, o mais recente; vazio se não há cook
+	static FString FindRegistry(const FString& ProjectFile);
+
+private:
+	struct FBatchPlugin
+	{
+		PluginScan::FScanPlugin Snapshot;
+		bool bEnabledByDefault = false;
+	};
+
+	static void MakeBatchPlugin(const FString& Name, const FString& BaseDir, const FPluginDescriptor& Descriptor,
+		bool bEnabledByDefault, FBatchPlugin& Out);
+
+	// Plugins habilitados no projeto: engine + Plugins/ do projeto, .uproject e
+	// dependências obrigatórias (como o plugin manager faz no boot)
+	bool GatherProjectPlugins(const FString& ProjectFile, TArray<PluginScan::FScanPlugin>& OutPlugins,
+		FString& OutError) const;
+
+	TArray<FBatchPlugin> EnginePlugins;
+};
@@ -0,0 +1,119 @@
+#include "PluginConfigScanner.h"
+
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace PluginScan
+{
+	namespace
+	{
+		template <typename CharType>
+		bool IsBlank(CharType C) { return C == ' ' || C == '\t' || C == '\r'; }
+
+		// "ActiveClassRedirects", "+ClassRedirects"... (sem alocar, ANSI ou TCHAR)
+		template <typename CharType>
+		bool IsRedirectKey(TStringView<CharType> Key)
+		{
+			static const char Suffix[] = "redirects";
+			constexpr int32 SuffixLen = UE_ARRAY_COUNT(Suffix) - 1;
+
+			while (Key.Len() && IsBlank(Key[Key.Len() - 1])) Key.LeftChopInline(1);
+			if (Key.Len() < SuffixLen)
+				return false;
+
+			for (int32 i = 0; i < SuffixLen; ++i)
+			{
+				CharType C = Key[Key.Len() - SuffixLen + i];
+				if (C >= 'A' && C <= 'Z') C += 'a' - 'A';
+				if (C != Suffix[i])
+					return false;
+			}
+			return true;
+		}
+
+		// Uma passada por linha: pula comentários e redirects (que apontam para
+		// nomes antigos, não para uso), e procura "/Script/" no resto
+		template <typename CharType>
+		void TokenizeIni(TStringView<CharType> Text, const FPluginModuleResolver& Resolver,
+			FPluginEvidenceIndex* Evidence, FName File, TBitArray<>& OutUsed)
+		{
+			int32 LineStart = 0;
+			while (LineStart < Text.Len())
+			{
+				int32 LineEnd = LineStart;
+				while (LineEnd < Text.Len() && Text[LineEnd] != '\n') ++LineEnd;
+
+				int32 First = LineStart;
+				while (First < LineEnd && IsBlank(Text[First])) ++First;
+
+				if (First < LineEnd && Text[First] != ';' && Text[First] != '#')
+				{
+					TStringView<CharType> Line = Text.Mid(First, LineEnd - First);
+
+					int32 Eq = INDEX_NONE;
+					const bool bIsRedirect = Line[0] != '[' && Line.FindChar('=', Eq) && IsRedirectKey(Line.Left(Eq));
+
+					if (!bIsRedirect)
+					{
+						Resolver.ForEachScriptReference(Line, [&](int32 PluginIdx)
+							{
+								MarkUsedWith(PluginIdx, OutUsed, Evidence, [&](FPluginEvidenceIndex& Index, int32 Idx)
+									{
+										Index.Add(Idx, EPluginEvidenceKind::ConfigFile, File, MakeEvidenceName(Line.TrimEnd()));
+									});
+							});
+					}
+				}
+				LineStart = LineEnd + 1;
+			}
+		}
+	}
+
+	void ParseIni(FAnsiStringView Bytes, const FPluginModuleResolver& Resolver,
+		FPluginEvidenceIndex* Evidence, FName File, TBitArray<>& OutUsed)
+	{
+		// UTF-16 (raro em .ini de projeto): converte e tokeniza como TCHAR
+		if (Bytes.Len() >= 2 && uint8(Bytes[0]) == 0xFF && uint8(Bytes[1]) == 0xFE)
+		{
+			FString Text;
+			FFileHelper::BufferToString(Text, reinterpret_cast<const uint8*>(Bytes.GetData()), Bytes.Len());
+			TokenizeIni(FStringView(Text), Resolver, Evidence, File, OutUsed);
+			return;
+		}
+		TokenizeIni(Bytes, Resolver, Evidence, File, OutUsed);
+	}
+
+	bool ScanProjectConfig(const FString& ConfigDir, const FPluginModuleResolver& Resolver,
+		const FScanContext& Ctx, TBitArray<>& InOutUsed)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(PluginScan_ProjectConfig);
+		IPlatformFile& PF = FPlatformFileManager::Get().GetPlatformFile();
+
+		// Default*.ini + <Plataforma>/<Plataforma>*.ini
+		TArray<FString> Files;
+		PF.IterateDirectoryRecursively(*ConfigDir, [&Files](const TCHAR* Path, bool bIsDir)
+			{
+				if (!bIsDir && FStringView(Path).EndsWith(TEXTVIEW(".ini"), ESearchCase::IgnoreCase))
+					Files.Add(Path);
+				return true;
+			});
+
+		FPluginScanCounters Counters;
+		Counters.ConfigFiles = Files.Num();
+		Ctx.AddCounters(Counters);
+
+		for (int32 FileIdx = 0; FileIdx < Files.Num(); ++FileIdx)
+		{
+			if (Ctx.IsCancelled()) return false;
+			Ctx.Report(EPluginScanPhase::ProjectConfig, float(FileIdx) / Files.Num());
+
+			const FName File = Ctx.Evidence ? FName(*FPaths::GetCleanFilename(Files[FileIdx])) : NAME_None;
+			VisitMappedFile(PF, Files[FileIdx], [&](FAnsiStringView Bytes)
+				{
+					ParseIni(Bytes, Resolver, Ctx.Evidence, File, InOutUsed);
+				});
+		}
+		return true;
+	}
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PluginScanCommon.h"
+
+/*
+ * Passada de config: tokeniza os .ini do projeto (Config/ e as pastas de
+ * plataforma) linha a linha, direto sobre o arquivo mapeado, e resolve cada
+ * "/Script/Module" de seção ou valor pelo mesmo resolver das outras passadas.
+ * Não monta FConfigFile: só interessa quais módulos aparecem.
+ */
+namespace PluginScan
+{
+	// Retorna false se foi cancelado
+	bool ScanProjectConfig(const FString& ConfigDir, const FPluginModuleResolver& Resolver,
+		const FScanContext& Ctx, TBitArray<>& InOutUsed);
+
+	// Módulos "/Script/..." de um .ini (ANSI/UTF-8 ou UTF-16 com BOM), fora de
+	// comentários e de chaves *Redirects
+	void ParseIni(FAnsiStringView Bytes, const FPluginModuleResolver& Resolver,
+		FPluginEvidenceIndex* Evidence, FName File, TBitArray<>& OutUsed);
+}
@@ -0,0 +1,153 @@
+#include "PluginDependencyGraph.h"
+#include "PluginScanCommon.h"
+
+namespace
+{
+	// true se A é subconjunto de B (mesmo tamanho)
+	bool IsSubsetOf(const TBitArray<>& A, const TBitArray<>& B)
+	{
+		for (TConstSetBitIterator<> It(A); It; ++It)
+		{
+			if (!B[It.GetIndex()])
+				return false;
+		}
+		return true;
+	}
+}
+
+void FPluginDependencyGraph::Build(const TArray<PluginScan::FScanPlugin>& Plugins)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(PluginScan_DependencyGraph);
+
+	const int32 N = Plugins.Num();
+
+	TMap<FString, int32> IndexByName;
+	IndexByName.Reserve(N);
+	for (int32 Idx = 0; Idx < N; ++Idx)
+		IndexByName.Add(Plugins[Idx].Name, Idx);
+
+	// arestas diretas
+	TArray<TArray<int32>> Direct;
+	Direct.SetNum(N);
+	DependsOn.SetNum(N);
+	for (int32 Idx = 0; Idx < N; ++Idx)
+	{
+		DependsOn[Idx].Init(false, N);
+		for (const FString& DepName : Plugins[Idx].Dependencies)
+		{
+			const int32* Dep = IndexByName.Find(DepName);
+			if (Dep && *Dep != Idx)
+			{
+				Direct[Idx].Add(*Dep);
+				DependsOn[Idx][*Dep] = true;
+			}
+		}
+	}
+
+	// Pós-ordem: cada plugin depois das suas dependências, então uma passada
+	// fecha um DAG. Ciclos (raros, mas o descritor permite) pedem mais passadas.
+	TArray<int32> Order;
+	Order.Reserve(N);
+	{
+		TBitArray<> Visited(false, N);
+		TArray<TPair<int32, int32>> Stack;      // (plugin, próxima aresta)
+		for (int32 Root = 0; Root < N; ++Root)
+		{
+			if (Visited[Root]) continue;
+			Visited[Root] = true;
+			Stack.Add({ Root, 0 });
+
+			while (Stack.Num())
+			{
+				TPair<int32, int32>& Top = Stack.Last();
+				if (Top.Value < Direct[Top.Key].Num())
+				{
+					const int32 Next = Direct[Top.Key][Top.Value++];
+					if (!Visited[Next])
+					{
+						Visited[Next] = true;
+						Stack.Add({ Next, 0 });
+					}
+				}
+				else
+				{
+					Order.Add(Top.Key);
+					Stack.Pop();
+				}
+			}
+		}
+	}
+
+	for (bool bChanged = true; bChanged; )
+	{
+		bChanged = false;
+		for (const int32 Idx : Order)
+		{
+			// OR só acrescenta bits: mudou <=> a contagem mudou
+			const int32 Before = DependsOn[Idx].CountSetBits();
+			for (const int32 Dep : Direct[Idx])
+				DependsOn[Idx].CombineWithBitwiseOR(DependsOn[Dep], EBitwiseOperatorFlags::MaintainSize);
+			bChanged |= (DependsOn[Idx].CountSetBits() != Before);
+		}
+	}
+
+	// um plugin num ciclo acaba dependendo de si mesmo
+	for (int32 Idx = 0; Idx < N; ++Idx)
+		DependsOn[Idx][Idx] = false;
+
+	// fecho reverso = transposta
+	RequiredBy.SetNum(N);
+	for (int32 Idx = 0; Idx < N; ++Idx)
+		RequiredBy[Idx].Init(false, N);
+	for (int32 Idx = 0; Idx < N; ++Idx)
+	{
+		for (TConstSetBitIterator<> It(DependsOn[Idx]); It; ++It)
+			RequiredBy[It.GetIndex()][Idx] = true;
+	}
+}
+
+TBitArray<> FPluginDependencyGraph::PropagateUsed(TBitArray<>& InOutUsed) const
+{
+	TBitArray<> Closure(false, Num());
+	for (TConstSetBitIterator<> It(InOutUsed); It; ++It)
+		Closure.CombineWithBitwiseOR(DependsOn[It.GetIndex()], EBitwiseOperatorFlags::MaintainSize);
+
+	// só o que ainda não estava marcado
+	TBitArray<> Added(false, Num());
+	for (TConstSetBitIterator<> It(Closure); It; ++It)
+	{
+		if (!InOutUsed[It.GetIndex()])
+		{
+			Added[It.GetIndex()] = true;
+			InOutUsed[It.GetIndex()] = true;
+		}
+	}
+	return Added;
+}
+
+TBitArray<> FPluginDependencyGraph::GetRemovableGroup(int32 Candidate, const TBitArray<>& Used) const
+{
+	TBitArray<> Group = RequiredBy[Candidate];
+	Group[Candidate] = true;
+
+	// dependências que ninguém fora do grupo usa também podem sair
+	for (bool bGrew = true; bGrew; )
+	{
+		bGrew = false;
+
+		TBitArray<> Deps(false, Num());
+		for (TConstSetBitIterator<> It(Group); It; ++It)
+			Deps.CombineWithBitwiseOR(DependsOn[It.GetIndex()], EBitwiseOperatorFlags::MaintainSize);
+
+		for (TConstSetBitIterator<> It(Deps); It; ++It)
+		{
+			const int32 Dep = It.GetIndex();
+			if (!Group[Dep] && !Used[Dep] && IsSubsetOf(RequiredBy[Dep], Group))
+			{
+				Group[Dep] = true;
+				bGrew = true;
+			}
+		}
+	}
+	return Group;
+}
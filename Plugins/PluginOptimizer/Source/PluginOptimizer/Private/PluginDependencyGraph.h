@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+namespace PluginScan { struct FScanPlugin; }
+
+/*
+ * Grafo de dependências entre os plugins habilitados, com os mesmos índices
+ * densos do snapshot de FScanPlugin. Guarda os fechos transitivos nos dois
+ * sentidos como bitsets (N x N bits: ~31 KB para 500 plugins).
+ */
+class FPluginDependencyGraph
+{
+public:
+	// Só arestas obrigatórias (não opcionais) entre plugins habilitados
+	void Build(const TArray<PluginScan::FScanPlugin>& Plugins);
+
+	int32 Num() const { return DependsOn.Num(); }
+
+	// Tudo que o plugin precisa, direta ou indiretamente (sem ele mesmo)
+	const TBitArray<>& GetDependencies(int32 PluginIdx) const { return DependsOn[PluginIdx]; }
+
+	// Tudo que precisa do plugin, direta ou indiretamente (sem ele mesmo)
+	const TBitArray<>& GetDependents(int32 PluginIdx) const { return RequiredBy[PluginIdx]; }
+
+	// Marca as dependências de tudo que está em InOutUsed; retorna só os bits novos
+	TBitArray<> PropagateUsed(TBitArray<>& InOutUsed) const;
+
+	// Plugins que saem junto com o candidato: quem depende dele e as dependências
+	// (não usadas) que ficariam sem nenhum dependente habilitado. Inclui o candidato.
+	TBitArray<> GetRemovableGroup(int32 Candidate, const TBitArray<>& Used) const;
+
+private:
+	TArray<TBitArray<>> DependsOn;
+	TArray<TBitArray<>> RequiredBy;
+};
@@ -0,0 +1,108 @@
+#include "PluginDisableBatch.h"
+
+#include "Interfaces/IPluginManager.h"
+#include "Interfaces/IProjectManager.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+#define LOCTEXT_NAMESPACE "PluginDisableBatch"
+
+namespace
+{
+	// Desfaz na ordem inversa; SetPluginEnabled(true) também remove a
+	// referência que o disable criou quando o plugin é habilitado por padrão
+	void Rollback(const TArray<FString>& Applied)
+	{
+		IProjectManager& ProjMgr = IProjectManager::Get();
+		FText Ignored;
+		for (int32 Idx = Applied.Num() - 1; Idx >= 0; --Idx)
+			ProjMgr.SetPluginEnabled(Applied[Idx], true, Ignored);
+	}
+}
+
+bool FPluginDisableBatch::Validate(const TArray<FString>& PluginNames, FText& OutFailReason)
+{
+	if (IProjectManager::Get().GetCurrentProject() == nullptr)
+	{
+		OutFailReason = LOCTEXT("NoProject", "No project is loaded.");
+		return false;
+	}
+
+	const FString ProjectFile = FPaths::GetProjectFilePath();
+	if (IFileManager::Get().IsReadOnly(*ProjectFile))
+	{
+		OutFailReason = FText::Format(LOCTEXT("ReadOnly", "{0} is read-only. Check it out before disabling plugins."),
+			FText::FromString(FPaths::GetCleanFilename(ProjectFile)));
+		return false;
+	}
+
+	IPluginManager& PluginMgr = IPluginManager::Get();
+	const TSet<FString> Removing(PluginNames);
+
+	for (const FString& Name : PluginNames)
+	{
+		TSharedPtr<IPlugin> Plugin = PluginMgr.FindPlugin(Name);
+		if (!Plugin.IsValid() || !Plugin->IsEnabled())
+		{
+			OutFailReason = FText::Format(LOCTEXT("NotEnabled", "Plugin '{0}' is not enabled."), FText::FromString(Name));
+			return false;
+		}
+	}
+
+	// quem fica não pode depender (sem ser opcional) de quem sai
+	for (const TSharedRef<IPlugin>& Plugin : PluginMgr.GetEnabledPlugins())
+	{
+		if (Removing.Contains(Plugin->GetName()))
+			continue;
+
+		for (const FPluginReferenceDescriptor& Dep : Plugin->GetDescriptor().Plugins)
+		{
+			if (Dep.bEnabled && !Dep.bOptional && Removing.Contains(Dep.Name))
+			{
+				OutFailReason = FText::Format(
+					LOCTEXT("Dependency", "Plugin '{0}' is still enabled and depends on '{1}'."),
+					FText::FromString(Plugin->GetName()), FText::FromString(Dep.Name));
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+bool FPluginDisableBatch::Apply(const TArray<FString>& PluginNames, FText& OutFailReason)
+{
+	if (PluginNames.IsEmpty())
+		return true;
+
+	if (!Validate(PluginNames, OutFailReason))
+		return false;
+
+	IProjectManager& ProjMgr = IProjectManager::Get();
+
+	// ------------------ aplica tudo em memória ------------------
+	TArray<FString> Applied;
+	for (const FString& Name : PluginNames)
+	{
+		FText Fail;
+		if (!ProjMgr.SetPluginEnabled(Name, false, Fail))
+		{
+			Rollback(Applied);
+			OutFailReason = FText::Format(LOCTEXT("DisableFailed", "Failed to disable plugin:\n{0}\n\n{1}"),
+				FText::FromString(Name), Fail);
+			return false;
+		}
+		Applied.Add(Name);
+	}
+
+	// ------------------ uma única escrita ------------------
+	FText SaveFail;
+	if (!ProjMgr.SaveCurrentProjectToDisk(SaveFail))
+	{
+		Rollback(Applied);
+		OutFailReason = FText::Format(LOCTEXT("SaveFailed", "Failed to save the project file:\n{0}"), SaveFail);
+		return false;
+	}
+	return true;
+}
+
+#undef LOCTEXT_NAMESPACE
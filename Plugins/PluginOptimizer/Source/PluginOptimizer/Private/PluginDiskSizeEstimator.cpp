@@ -0,0 +1,180 @@
+#include "PluginDiskSizeEstimator.h"
+
+#include "Interfaces/IPluginManager.h"
+#include "Async/Async.h"
+#include "Async/ParallelFor.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "Serialization/Archive.h"
+
+namespace
+{
+	constexpr uint32 CacheMagic = 0x504F4453;     // "PODS"
+	constexpr uint32 CacheVersion = 1;
+
+	// Pastas medidas, na ordem dos campos de FPluginDiskSize
+	const TCHAR* const Categories[] = { TEXT("Binaries"), TEXT("Content"), TEXT("Shaders"), TEXT("Resources") };
+	constexpr int32 NumCategories = UE_ARRAY_COUNT(Categories);
+
+	int64& GetCategory(FPluginDiskSize& Size, int32 Category)
+	{
+		int64* Fields[] = { &Size.Binaries, &Size.Content, &Size.Shaders, &Size.Resources };
+		return *Fields[Category];
+	}
+
+	struct FDirEntry
+	{
+		FDateTime Timestamp;
+		int64 FileBytes = 0;            // só os arquivos diretos
+		TArray<FString> SubDirs;        // nomes, sem o caminho
+
+		friend FArchive& operator<<(FArchive& Ar, FDirEntry& E)
+		{
+			return Ar << E.Timestamp << E.FileBytes << E.SubDirs;
+		}
+	};
+	using FDirCache = TMap<FString, FDirEntry>;
+
+	void LoadCache(const FString& Path, FDirCache& OutCache)
+	{
+		TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileReader(*Path));
+		if (!Ar) return;
+
+		uint32 Magic = 0, Version = 0;
+		*Ar << Magic << Version;
+		if (Magic != CacheMagic || Version != CacheVersion)
+			return;
+
+		*Ar << OutCache;
+		if (Ar->IsError())
+			OutCache.Reset();
+	}
+
+	bool SaveCache(const FString& Path, FDirCache& Cache)
+	{
+		// nome único: várias estimativas podem estar rodando ao mesmo tempo
+		const FString TempPath = FPaths::CreateTempFilename(*FPaths::GetPath(Path), TEXT("DiskSizes"), TEXT(".tmp"));
+		bool bWritten = false;
+		{
+			TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileWriter(*TempPath));
+			if (!Ar) return false;
+
+			uint32 Magic = CacheMagic, Version = CacheVersion;
+			*Ar << Magic << Version << Cache;
+			bWritten = Ar->Close();
+		}
+		if (bWritten && IFileManager::Get().Move(*Path, *TempPath, true, true))
+			return true;
+
+		IFileManager::Get().Delete(*TempPath, false, false, true);
+		return false;
+	}
+
+	// Bytes sob Dir (recursivo). Só pastas com timestamp diferente do cache são listadas
+	int64 MeasureDirectory(IPlatformFile& PF, const FString& Dir, const FDirCache& OldCache, FDirCache& OutCache)
+	{
+		const FFileStatData Stat = PF.GetStatData(*Dir);
+		if (!Stat.bIsValid || !Stat.bIsDirectory)
+			return 0;
+
+		FDirEntry Entry;
+		const FDirEntry* Old = OldCache.Find(Dir);
+		if (Old && Old->Timestamp == Stat.ModificationTime)
+		{
+			Entry = *Old;
+		}
+		else
+		{
+			Entry.Timestamp = Stat.ModificationTime;
+			PF.IterateDirectoryStat(*Dir, [&Entry](const TCHAR* Path, const FFileStatData& Data)
+				{
+					if (Data.bIsDirectory)
+						Entry.SubDirs.Add(FPaths::GetCleanFilename(Path));
+					else if (Data.FileSize > 0)
+						Entry.FileBytes += Data.FileSize;
+					return true;
+				});
+		}
+
+		int64 Total = Entry.FileBytes;
+		for (const FString& Sub : Entry.SubDirs)
+			Total += MeasureDirectory(PF, FPaths::Combine(Dir, Sub), OldCache, OutCache);
+
+		OutCache.Add(Dir, MoveTemp(Entry));
+		return Total;
+	}
+}
+
+FPluginDiskSize& FPluginDiskSize::operator+=(const FPluginDiskSize& Other)
+{
+	Binaries  += Other.Binaries;
+	Content   += Other.Content;
+	Shaders   += Other.Shaders;
+	Resources += Other.Resources;
+	return *this;
+}
+
+FString FPluginDiskSizeEstimator::GetDefaultCachePath()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("PluginOptimizer"), TEXT("DiskSizes.bin"));
+}
+
+TMap<FString, FPluginDiskSize> FPluginDiskSizeEstimator::Estimate(const TMap<FString, FString>& BaseDirs,
+	const FString& CachePath)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(PluginOptimizer_EstimateDiskSizes);
+
+	FDirCache OldCache;
+	LoadCache(CachePath, OldCache);
+
+	TArray<FString> Names, Dirs;
+	BaseDirs.GenerateKeyArray(Names);
+	BaseDirs.GenerateValueArray(Dirs);
+
+	// uma tarefa por (plugin, pasta): plugins com Content/ grande não seguram os outros
+	const int32 NumJobs = Names.Num() * NumCategories;
+	TArray<int64> Bytes;
+	Bytes.SetNumZeroed(NumJobs);
+	TArray<FDirCache> NewCaches;
+	NewCaches.SetNum(NumJobs);
+
+	IPlatformFile& PF = FPlatformFileManager::Get().GetPlatformFile();
+	ParallelFor(NumJobs, [&](int32 Job)
+		{
+			const FString Root = FPaths::Combine(Dirs[Job / NumCategories], Categories[Job % NumCategories]);
+			Bytes[Job] = MeasureDirectory(PF, Root, OldCache, NewCaches[Job]);
+		});
+
+	TMap<FString, FPluginDiskSize> Sizes;
+	FDirCache NewCache;
+	for (int32 Job = 0; Job < NumJobs; ++Job)
+	{
+		GetCategory(Sizes.FindOrAdd(Names[Job / NumCategories]), Job % NumCategories) = Bytes[Job];
+		NewCache.Append(MoveTemp(NewCaches[Job]));
+	}
+
+	// pastas que sumiram (ou plugins desativados) saem do cache
+	SaveCache(CachePath, NewCache);
+	return Sizes;
+}
+
+void FPluginDiskSizeEstimator::EstimateAsync(TFunction<void(TMap<FString, FPluginDiskSize>&&)> OnComplete)
+{
+	check(IsInGameThread());
+
+	// IPluginManager não é thread-safe: copia as raízes aqui
+	TMap<FString, FString> BaseDirs;
+	for (const TSharedRef<IPlugin>& Plugin : IPluginManager::Get().GetEnabledPlugins())
+		BaseDirs.Add(Plugin->GetName(), FPaths::ConvertRelativePathToFull(Plugin->GetBaseDir()));
+
+	Async(EAsyncExecution::ThreadPool, [BaseDirs = MoveTemp(BaseDirs), OnComplete = MoveTemp(OnComplete)]() mutable
+		{
+			TMap<FString, FPluginDiskSize> Sizes = Estimate(BaseDirs);
+			AsyncTask(ENamedThreads::GameThread, [Sizes = MoveTemp(Sizes), OnComplete = MoveTemp(OnComplete)]() mutable
+				{
+					OnComplete(MoveTemp(Sizes));
+				});
+		});
+}
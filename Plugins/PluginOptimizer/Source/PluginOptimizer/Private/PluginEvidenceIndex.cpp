@@ -0,0 +1,86 @@
+#include "PluginEvidenceIndex.h"
+
+#define LOCTEXT_NAMESPACE "PluginEvidenceIndex"
+
+FPluginEvidenceIndex::FPluginEvidenceIndex(int32 NumPlugins, int32 InMaxPerPlugin)
+	: MaxPerPlugin(InMaxPerPlugin)
+{
+	Entries.SetNum(NumPlugins * MaxPerPlugin);
+	NumEntries.SetNumZeroed(NumPlugins);
+	TotalHits.SetNumZeroed(NumPlugins);
+}
+
+int32 FPluginEvidenceIndex::Intern(FName Name)
+{
+	if (Name.IsNone())
+		return INDEX_NONE;
+
+	if (const int32* Idx = PoolIndex.Find(Name))
+		return *Idx;
+
+	const int32 Idx = Pool.Add(Name);
+	PoolIndex.Add(Name, Idx);
+	return Idx;
+}
+
+void FPluginEvidenceIndex::Add(int32 PluginIdx, EPluginEvidenceKind Kind, FName Subject, FName Detail, FName Tag)
+{
+	if (NumEntries[PluginIdx] >= MaxPerPlugin)
+		return;
+
+	FPluginEvidence& E = Entries[PluginIdx * MaxPerPlugin + NumEntries[PluginIdx]++];
+	E.Kind = Kind;
+	E.Subject = Intern(Subject);
+	E.Detail = Intern(Detail);
+	E.Tag = Intern(Tag);
+}
+
+void FPluginEvidenceIndex::Merge(const FPluginEvidenceIndex& Other)
+{
+	check(Other.GetNumPlugins() == GetNumPlugins());
+
+	for (int32 PlgIdx = 0; PlgIdx < GetNumPlugins(); ++PlgIdx)
+	{
+		TotalHits[PlgIdx] += Other.TotalHits[PlgIdx];
+		for (const FPluginEvidence& E : Other.Get(PlgIdx))
+			Add(PlgIdx, E.Kind, Other.GetName(E.Subject), Other.GetName(E.Detail), Other.GetName(E.Tag));
+	}
+}
+
+FText FPluginEvidenceIndex::Describe(const FPluginEvidence& E) const
+{
+	const FText Subject = FText::FromName(GetName(E.Subject));
+	const FText Detail = FText::FromName(GetName(E.Detail));
+
+	switch (E.Kind)
+	{
+	case EPluginEvidenceKind::AssetClass:
+		return FText::Format(LOCTEXT("AssetClass", "Asset class: {0}.{1}"), Subject, Detail);
+	case EPluginEvidenceKind::ClassTag:
+		return FText::Format(LOCTEXT("ClassTag", "{2} of {0}.{1}"), Subject, Detail, FText::FromName(GetName(E.Tag)));
+	case EPluginEvidenceKind::PackageImport:
+		return FText::Format(LOCTEXT("PackageImport", "{0} imports {1}"), Subject, Detail);
+	case EPluginEvidenceKind::PackageDependency:
+		return FText::Format(LOCTEXT("PackageDependency", "{0} depends on {1}"), Subject, Detail);
+	case EPluginEvidenceKind::Referencer:
+		return FText::Format(LOCTEXT("Referencer", "{1} is referenced by {0}"), Subject, Detail);
+	case EPluginEvidenceKind::CachedPackage:
+		return FText::Format(LOCTEXT("CachedPackage", "{0} (unchanged since last scan)"), Subject);
+	case EPluginEvidenceKind::SourceFile:
+		return FText::Format(LOCTEXT("SourceFile", "{0}: {1}"), Subject, Detail);
+	case EPluginEvidenceKind::ConfigFile:
+		return FText::Format(LOCTEXT("ConfigFile", "{0}: {1}"), Subject, Detail);
+	case EPluginEvidenceKind::LoadedModule:
+		return FText::Format(LOCTEXT("LoadedModule", "Module {0} is loaded"), Subject);
+	default:
+		return FText::Format(LOCTEXT("Dependency", "Required by {0}"), Subject);
+	}
+}
+
+SIZE_T FPluginEvidenceIndex::GetAllocatedSize() const
+{
+	return Pool.GetAllocatedSize() + PoolIndex.GetAllocatedSize() + Entries.GetAllocatedSize()
+		+ NumEntries.GetAllocatedSize() + TotalHits.GetAllocatedSize();
+}
+
+#undef LOCTEXT_NAMESPACE
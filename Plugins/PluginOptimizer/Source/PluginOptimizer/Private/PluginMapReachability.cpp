@@ -0,0 +1,333 @@
+#include "PluginMapReachability.h"
+#include "PluginScanCommon.h"
+#include "PluginScanSource.h"
+#include "PluginDependencyGraph.h"
+
+#include "AssetRegistry/AssetData.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "Misc/Crc.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+namespace
+{
+	using namespace PluginScan;
+
+	bool IsMapAsset(const FAssetData& AD)
+	{
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 1
+		return AD.AssetClass == NAME_World;
+#else
+		static const FTopLevelAssetPath WorldClass(TEXT("/Script/Engine"), TEXT("World"));
+		return AD.AssetClassPath == WorldClass;
+#endif
+	}
+
+	// "/Game/__ExternalActors__/Maps/A/0/XY/Z" -> "/Game/Maps/A/0/XY/Z"; vazio se não for actor externo
+	FString StripExternalFolder(FName PackageName)
+	{
+		FString Name = PackageName.ToString();
+		for (const TCHAR* Folder : { TEXT("/__ExternalActors__"), TEXT("/__ExternalObjects__") })
+		{
+			const int32 Pos = Name.Find(Folder, ESearchCase::CaseSensitive);
+			if (Pos != INDEX_NONE)
+			{
+				Name.RemoveAt(Pos, FCString::Strlen(Folder));
+				return Name;
+			}
+		}
+		return FString();
+	}
+
+	/*
+	 * Grafo dos pacotes alcançados pelos mapas, em CSR: as arestas do nó N
+	 * ficam em Edges[EdgeStart[N] .. EdgeStart[N + 1]). Só /Game e o conteúdo
+	 * dos plugins são expandidos; "/Script/" e /Engine são folhas.
+	 */
+	struct FPackageGraph
+	{
+		TArray<FName> Nodes;
+		TMap<FName, int32> NodeIndex;
+		TArray<int32> NodePlugin;           // dono do pacote (raiz de conteúdo ou módulo)
+		TBitArray<> Expand;
+		TArray<int32> EdgeStart;
+		TArray<int32> Edges;
+
+		int32 AddNode(FName Name, const FPluginModuleResolver& Resolver)
+		{
+			if (const int32* Found = NodeIndex.Find(Name))
+				return *Found;
+
+			const int32 Plugin = Resolver.FindByPackageName(Name);
+			TStringBuilder<256> Path;
+			Name.AppendString(Path);
+
+			const int32 Idx = Nodes.Add(Name);
+			NodeIndex.Add(Name, Idx);
+			NodePlugin.Add(Plugin);
+			Expand.Add(Path.ToView().StartsWith(TEXTVIEW("/Game/"))
+				|| (Plugin != INDEX_NONE && Resolver.FindByScriptPackage(Name) == INDEX_NONE));
+			return Idx;
+		}
+	};
+
+	// Conjuntos de plugins distintos; o 0 é o vazio
+	struct FPluginSetTable
+	{
+		TArray<TBitArray<>> Sets;
+		TMultiMap<uint32, int32> ByHash;
+
+		explicit FPluginSetTable(int32 NumPlugins)
+		{
+			Sets.Emplace(false, NumPlugins);
+		}
+
+		int32 Intern(const TBitArray<>& Bits)
+		{
+			const uint32 Hash = FCrc::MemCrc32(Bits.GetData(), FMath::DivideAndRoundUp(Bits.Num(), 32) * sizeof(uint32));
+			TArray<int32, TInlineAllocator<4>> Candidates;
+			ByHash.MultiFind(Hash, Candidates);
+			for (const int32 SetIdx : Candidates)
+				if (Sets[SetIdx] == Bits)
+					return SetIdx;
+
+			const int32 SetIdx = Sets.Add(Bits);
+			ByHash.Add(Hash, SetIdx);
+			return SetIdx;
+		}
+	};
+}
+
+void PluginScan::RunMapReachability(const TArray<FScanPlugin>& Plugins, const FPluginScanOptions& Options,
+	const IPluginScanSource& Source, FPluginMapReachability& Out)
+{
+	LLM_SCOPE_BYNAME(TEXT("PluginOptimizer"));
+	TRACE_CPUPROFILER_EVENT_SCOPE(PluginScan_MapReachability);
+	const double Start = FPlatformTime::Seconds();
+
+	const int32 NumPlugins = Plugins.Num();
+	Out.Plugins.Reset();
+	for (const FScanPlugin& P : Plugins)
+		Out.Plugins.Add(P.Name);
+
+	FPluginModuleResolver Resolver;
+	BuildResolver(Plugins, Resolver);
+
+	// ------------------ mapas e actors externos de /Game ------------------
+	TSet<FName> MapSet;
+	TSet<FName> ExternalPackages;
+	Source.EnumerateAssetsByPath("/Game", Options.AssetBatchSize, [&](TConstArrayView<FAssetData> Batch)
+		{
+			for (const FAssetData& AD : Batch)
+			{
+				if (IsMapAsset(AD))
+					MapSet.Add(AD.PackageName);
+				else if (IsExternalActorPackage(AD.PackageName))
+					ExternalPackages.Add(AD.PackageName);
+			}
+			return true;
+		});
+
+	Out.Maps = MapSet.Array();
+	Out.Maps.Sort(FNameLexicalLess());
+
+	// World Partition: o mapa não depende dos seus actors externos (é o
+	// contrário), então a aresta mapa -> actor é criada aqui pela pasta
+	TMap<FName, TArray<FName>> ExternalByMap;
+	for (const FName Pkg : ExternalPackages)
+	{
+		FString Path = StripExternalFolder(Pkg);
+		int32 Slash;
+		while (Path.FindLastChar(TEXT('/'), Slash) && Slash > 0)
+		{
+			Path.LeftInline(Slash);
+			const FName MapName(*Path, FNAME_Find);
+			if (!MapName.IsNone() && MapSet.Contains(MapName))
+			{
+				ExternalByMap.FindOrAdd(MapName).Add(Pkg);
+				break;
+			}
+		}
+	}
+	ExternalPackages.Empty();
+
+	// ------------------ grafo em ondas ------------------
+	FPackageGraph Graph;
+	for (const FName Map : Out.Maps)
+		Graph.AddNode(Map, Resolver);
+
+	std::atomic<int64> Queries{ 0 };
+	TArray<TArray<FName>> WaveDeps;
+	int32 WaveBegin = 0;
+	while (WaveBegin < Graph.Nodes.Num())
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(PluginScan_MapReachabilityWave);
+
+		const int32 WaveEnd = Graph.Nodes.Num();
+		WaveDeps.SetNum(WaveEnd - WaveBegin);
+		ParallelFor(WaveEnd - WaveBegin, [&](int32 Offset)
+			{
+				const int32 Node = WaveBegin + Offset;
+				TArray<FName>& Deps = WaveDeps[Offset];
+				Deps.Reset();
+				if (!Graph.Expand[Node])
+					return;
+
+				Source.GetDependencies(Graph.Nodes[Node], Deps);
+				++Queries;
+				if (const TArray<FName>* External = ExternalByMap.Find(Graph.Nodes[Node]))
+					Deps.Append(*External);
+			});
+
+		// nós novos entram no fim: viram a próxima onda
+		for (int32 Offset = 0; Offset < WaveEnd - WaveBegin; ++Offset)
+		{
+			Graph.EdgeStart.Add(Graph.Edges.Num());
+			for (const FName Dep : WaveDeps[Offset])
+			{
+				const int32 Target = Graph.AddNode(Dep, Resolver);
+				if (Target != WaveBegin + Offset)
+					Graph.Edges.Add(Target);
+			}
+		}
+		WaveBegin = WaveEnd;
+	}
+	Graph.EdgeStart.Add(Graph.Edges.Num());
+	WaveDeps.Empty();
+
+	// ------------------ Tarjan iterativo ------------------
+	const int32 NumNodes = Graph.Nodes.Num();
+	TArray<int32> Order, Low, Component;
+	Order.Init(INDEX_NONE, NumNodes);
+	Low.SetNumUninitialized(NumNodes);
+	Component.Init(INDEX_NONE, NumNodes);
+	TBitArray<> OnStack(false, NumNodes);
+
+	TArray<int32> Stack;
+	struct FFrame { int32 Node; int32 NextEdge; };
+	TArray<FFrame> CallStack;
+
+	FPluginSetTable Table(NumPlugins);
+	TArray<int32> ComponentSet;                 // componente -> índice em Table
+	TBitArray<> Scratch;
+	int32 Counter = 0;
+
+	auto Visit = [&](int32 Node)
+		{
+			Order[Node] = Low[Node] = Counter++;
+			Stack.Push(Node);
+			OnStack[Node] = true;
+			CallStack.Add({ Node, Graph.EdgeStart[Node] });
+		};
+
+	// componente pronto: membros no topo da pilha até Root; sucessores já resolvidos
+	auto CloseComponent = [&](int32 Root)
+		{
+			const int32 Comp = ComponentSet.Num();
+			const int32 FirstMember = Stack.FindLast(Root);     // Root é o mais fundo dos membros
+			int32 Single = 0;
+			bool bBuild = false;
+
+			for (int32 Pos = FirstMember; Pos < Stack.Num(); ++Pos)
+			{
+				const int32 Member = Stack[Pos];
+				bBuild |= Graph.NodePlugin[Member] != INDEX_NONE;
+				for (int32 E = Graph.EdgeStart[Member]; E < Graph.EdgeStart[Member + 1]; ++E)
+				{
+					const int32 TargetComp = Component[Graph.Edges[E]];
+					if (TargetComp == INDEX_NONE)
+						continue;           // mesmo componente
+					const int32 Set = ComponentSet[TargetComp];
+					if (Set == 0 || Set == Single)
+						continue;
+					if (Single == 0)
+						Single = Set;
+					else
+						bBuild = true;
+				}
+			}
+
+			// cadeia sem plugin próprio e com um único conjunto a jusante: reaproveita
+			int32 SetIdx = Single;
+			if (bBuild)
+			{
+				Scratch.Init(false, NumPlugins);
+				for (int32 Pos = FirstMember; Pos < Stack.Num(); ++Pos)
+				{
+					const int32 Member = Stack[Pos];
+					MarkUsed(Graph.NodePlugin[Member], Scratch);
+					for (int32 E = Graph.EdgeStart[Member]; E < Graph.EdgeStart[Member + 1]; ++E)
+					{
+						const int32 TargetComp = Component[Graph.Edges[E]];
+						if (TargetComp != INDEX_NONE)
+							Scratch.CombineWithBitwiseOR(Table.Sets[ComponentSet[TargetComp]], EBitwiseOperatorFlags::MaintainSize);
+					}
+				}
+				SetIdx = Table.Intern(Scratch);
+			}
+
+			ComponentSet.Add(SetIdx);
+			for (int32 Pos = FirstMember; Pos < Stack.Num(); ++Pos)
+			{
+				Component[Stack[Pos]] = Comp;
+				OnStack[Stack[Pos]] = false;
+			}
+			Stack.SetNum(FirstMember);
+		};
+
+	for (int32 Root = 0; Root < NumNodes; ++Root)
+	{
+		if (Order[Root] != INDEX_NONE)
+			continue;
+
+		Visit(Root);
+		while (CallStack.Num())
+		{
+			const int32 Node = CallStack.Last().Node;
+			int32& NextEdge = CallStack.Last().NextEdge;
+			if (NextEdge < Graph.EdgeStart[Node + 1])
+			{
+				const int32 Target = Graph.Edges[NextEdge++];
+				if (Order[Target] == INDEX_NONE)
+					Visit(Target);          // invalida NextEdge
+				else if (OnStack[Target])
+					Low[Node] = FMath::Min(Low[Node], Order[Target]);
+				continue;
+			}
+
+			CallStack.Pop();
+			if (CallStack.Num())
+			{
+				const int32 Parent = CallStack.Last().Node;
+				Low[Parent] = FMath::Min(Low[Parent], Low[Node]);
+			}
+			if (Low[Node] == Order[Node])
+				CloseComponent(Node);
+		}
+	}
+
+	// ------------------ dependências entre plugins + matriz ------------------
+	FPluginDependencyGraph PluginGraph;
+	PluginGraph.Build(Plugins);
+	for (TBitArray<>& Set : Table.Sets)
+		PluginGraph.PropagateUsed(Set);
+
+	Out.Reached.Reset(Out.Maps.Num());
+	for (const FName Map : Out.Maps)
+		Out.Reached.Add(Table.Sets[ComponentSet[Component[Graph.NodeIndex.FindChecked(Map)]]]);
+
+	Out.NumPackages = NumNodes;
+	Out.NumComponents = ComponentSet.Num();
+	Out.NumDistinctSets = Table.Sets.Num() - 1;
+	Out.DependencyQueries = Queries;
+	Out.Seconds = FPlatformTime::Seconds() - Start;
+}
+
+int32 FPluginMapReachability::GetNumMapsReaching(int32 PluginIdx) const
+{
+	int32 Count = 0;
+	for (const TBitArray<>& Bits : Reached)
+		Count += Bits[PluginIdx] ? 1 : 0;
+	return Count;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PluginUsageScanner.h"
+
+class IPluginScanSource;
+
+/*
+ * Alcance por mapa: a partir de cada .umap de /Game, o grafo de pacotes é
+ * levantado em ondas (as consultas de dependência de cada onda rodam em
+ * paralelo) e depois condensado em componentes fortemente conexos (Tarjan).
+ * Os componentes saem com os sucessores já prontos, então o conjunto de
+ * plugins de cada um é o OR dos sucessores e cada subgrafo compartilhado é
+ * resolvido uma única vez. Conjuntos iguais são internados.
+ */
+namespace PluginScan
+{
+	struct FScanPlugin;
+
+	// Corpo de FPluginUsageScanner::ScanMapReachability sobre qualquer fonte
+	void RunMapReachability(const TArray<FScanPlugin>& Plugins, const FPluginScanOptions& Options,
+		const IPluginScanSource& Source, FPluginMapReachability& Out);
+}
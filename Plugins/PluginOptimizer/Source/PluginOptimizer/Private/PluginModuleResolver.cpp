@@ -0,0 +1,89 @@
+#include "PluginModuleResolver.h"
+
+const FStringView FPluginModuleResolver::ScriptPrefix = TEXTVIEW("/Script/");
+
+void FPluginModuleResolver::AddModule(FName ModuleName, int32 PluginIndex)
+{
+	ModuleToPlugin.Add(ModuleName, PluginIndex);
+
+	TStringBuilder<256> Package;
+	Package << ScriptPrefix << ModuleName;
+	ScriptPackageToPlugin.Add(FName(Package.ToView()), PluginIndex);
+}
+
+void FPluginModuleResolver::AddMountPath(FStringView MountPath, int32 PluginIndex)
+{
+	const FStringView Root = ExtractMountRoot(MountPath);
+	if (Root.Len() > 1)
+		MountRootToPlugin.Add(FName(Root), PluginIndex);
+}
+
+int32 FPluginModuleResolver::FindByPackageName(FName PackageName) const
+{
+	if (const int32* Idx = ScriptPackageToPlugin.Find(PackageName))
+		return *Idx;
+	if (Base)
+	{
+		const int32 Idx = ToLocal(Base->FindByPackageName(PackageName));
+		if (Idx != INDEX_NONE)
+			return Idx;
+	}
+
+	// só o primeiro segmento importa; o builder fica na pilha
+	TStringBuilder<256> Path;
+	PackageName.AppendString(Path);
+
+	const FStringView Root = ExtractMountRoot(Path.ToView());
+	if (Root.Len() <= 1)
+		return INDEX_NONE;
+
+	const FName RootName(Root, FNAME_Find);
+	if (RootName.IsNone())
+		return INDEX_NONE;
+
+	const int32* Idx = MountRootToPlugin.Find(RootName);
+	return Idx ? *Idx : INDEX_NONE;
+}
+
+FStringView FPluginModuleResolver::ExtractMountRoot(FStringView PackageName)
+{
+	if (!PackageName.StartsWith(TEXT('/')))
+		return FStringView();
+
+	int32 Slash = INDEX_NONE;
+	if (PackageName.RightChop(1).FindChar(TEXT('/'), Slash))
+		return PackageName.Left(Slash + 1);
+	return PackageName;
+}
+
+int32 FPluginModuleResolver::FindByScriptPackageView(FStringView Package) const
+{
+	if (Package.Len() <= ScriptPrefix.Len() || Package.Len() >= NAME_SIZE)
+		return INDEX_NONE;
+
+	// FNAME_Find não cria entradas: nome inexistente = não é módulo de plugin
+	const FName Name(Package, FNAME_Find);
+	return Name.IsNone() ? INDEX_NONE : FindByScriptPackage(Name);
+}
+
+int32 FPluginModuleResolver::FindByScriptPackageView(FAnsiStringView Package) const
+{
+	if (Package.Len() <= ScriptPrefix.Len() || Package.Len() >= NAME_SIZE)
+		return INDEX_NONE;
+
+	const FName Name(Package.Len(), Package.GetData(), FNAME_Find);
+	return Name.IsNone() ? INDEX_NONE : FindByScriptPackage(Name);
+}
+
+int32 FPluginModuleResolver::FindByClassPath(FStringView ClassPath) const
+{
+	// export path: Class'/Script/Module.Object'  ->  só a parte entre aspas
+	int32 Quote = INDEX_NONE;
+	if (ClassPath.FindChar(TEXT('\''), Quote))
+		ClassPath = ClassPath.RightChop(Quote + 1);
+
+	if (!ClassPath.StartsWith(ScriptPrefix, ESearchCase::IgnoreCase))
+		return INDEX_NONE;
+
+	return FindByScriptPackageView(ExtractScriptPackage(ClassPath));
+}
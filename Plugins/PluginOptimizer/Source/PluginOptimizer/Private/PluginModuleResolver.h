@@ -0,0 +1,123 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*
+ * Resolve referências "/Script/Module" para o índice denso do plugin dono do
+ * módulo, e pacotes de conteúdo pela raiz do mount ("/Plugin/..."). As buscas
+ * recebem FName ou FStringView e não alocam: um pacote que não existe na
+ * tabela de nomes não pode ser de nenhum plugin.
+ *
+ * Um resolver pode ficar por cima de outro compartilhado (SetBase): o batch
+ * monta o dos plugins do engine uma vez e cada projeto só adiciona os seus.
+ */
+class FPluginModuleResolver
+{
+public:
+	void AddModule(FName ModuleName, int32 PluginIndex);
+
+	// MountPath no formato de IPlugin::GetMountedAssetPath ("/Plugin/")
+	void AddMountPath(FStringView MountPath, int32 PluginIndex);
+
+	// O que não está nesta camada cai em Base, com o índice traduzido por
+	// BaseToLocal (INDEX_NONE = plugin da base fora deste scan). Base e
+	// BaseToLocal precisam viver mais que este resolver
+	void SetBase(const FPluginModuleResolver* InBase, TConstArrayView<int32> InBaseToLocal)
+	{
+		Base = InBase;
+		BaseToLocal = InBaseToLocal;
+	}
+
+	// Qualquer dependência de pacote: "/Script/Module" ou conteúdo em "/Plugin/..."
+	int32 FindByPackageName(FName PackageName) const;
+
+	// "/Script/Module" -> plugin (INDEX_NONE se não for de plugin habilitado)
+	int32 FindByScriptPackage(FName PackageName) const
+	{
+		const int32* Idx = ScriptPackageToPlugin.Find(PackageName);
+		return Idx ? *Idx : Base ? ToLocal(Base->FindByScriptPackage(PackageName)) : INDEX_NONE;
+	}
+
+	// "Module" -> plugin
+	int32 FindByModuleName(FName ModuleName) const
+	{
+		const int32* Idx = ModuleToPlugin.Find(ModuleName);
+		return Idx ? *Idx : Base ? ToLocal(Base->FindByModuleName(ModuleName)) : INDEX_NONE;
+	}
+
+	// "/Script/Module.Class", "/Script/Module" ou export path "Class'/Script/Module.Class'"
+	int32 FindByClassPath(FStringView ClassPath) const;
+
+	// Chama Visit(PluginIndex) para cada "/Script/Module" de plugin encontrado em Text.
+	// Também aceita texto ANSI/UTF-8 direto de um arquivo mapeado.
+	template <typename CharType, typename FuncType>
+	void ForEachScriptReference(TStringView<CharType> Text, FuncType&& Visit) const
+	{
+		const TStringView<CharType> Prefix = GetScriptPrefix<CharType>();
+
+		int32 Pos = 0;
+		while ((Pos = Text.Find(Prefix, Pos, ESearchCase::IgnoreCase)) != INDEX_NONE)
+		{
+			const TStringView<CharType> Package = ExtractScriptPackage(Text.RightChop(Pos));
+			const int32 Idx = FindByScriptPackageView(Package);
+			if (Idx != INDEX_NONE)
+				Visit(Idx);
+			Pos += FMath::Max(Package.Len(), Prefix.Len());
+		}
+	}
+
+	template <typename FuncType>
+	void ForEachScriptReference(const FString& Text, FuncType&& Visit) const
+	{
+		ForEachScriptReference(FStringView(Text), Forward<FuncType>(Visit));
+	}
+
+	// Só os desta camada (sem os da base)
+	const TMap<FName, int32>& GetModules() const { return ModuleToPlugin; }
+
+	static const FStringView ScriptPrefix;
+
+private:
+	template <typename CharType>
+	static TStringView<CharType> GetScriptPrefix();
+
+	int32 ToLocal(int32 BaseIdx) const
+	{
+		return BaseToLocal.IsValidIndex(BaseIdx) ? BaseToLocal[BaseIdx] : INDEX_NONE;
+	}
+
+	// Text começa em "/Script/"; devolve só "/Script/Module"
+	template <typename CharType>
+	static TStringView<CharType> ExtractScriptPackage(TStringView<CharType> Text)
+	{
+		int32 End = ScriptPrefix.Len();
+		while (End < Text.Len())
+		{
+			const CharType C = Text[End];
+			if (C == '.' || C == ':' || C == '\'' || C == '"' || C == ',' || C == ')' ||
+				C == ' ' || C == '\t' || C == '\r' || C == '\n')
+				break;
+			++End;
+		}
+		return Text.Left(End);
+	}
+
+	int32 FindByScriptPackageView(FStringView Package) const;
+	int32 FindByScriptPackageView(FAnsiStringView Package) const;
+
+	// "/Plugin/Pasta/Asset" -> "/Plugin"
+	static FStringView ExtractMountRoot(FStringView PackageName);
+
+	TMap<FName, int32> ScriptPackageToPlugin;
+	TMap<FName, int32> ModuleToPlugin;
+	TMap<FName, int32> MountRootToPlugin;
+
+	const FPluginModuleResolver* Base = nullptr;
+	TConstArrayView<int32> BaseToLocal;
+};
+
+template <>
+inline FStringView FPluginModuleResolver::GetScriptPrefix<TCHAR>() { return ScriptPrefix; }
+
+template <>
+inline FAnsiStringView FPluginModuleResolver::GetScriptPrefix<ANSICHAR>() { return ANSITEXTVIEW("/Script/"); }
@@ -0,0 +1,330 @@
+#include "PluginOptimizerBenchmarkCommandlet.h"
+#include "PluginUsageScanner.h"
+#include "PluginScanCommon.h"
+#include "PluginSyntheticRegistry.h"
+
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformMemory.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPluginOptimizerBenchmark, Log, All);
+
+using namespace PluginScan;
+
+namespace
+{
+	// Abaixo disso a variação entre execuções é maior que qualquer regressão real
+	constexpr double NoiseFloorSeconds = 0.01;
+	constexpr double NoiseFloorMB = 32.0;
+
+	double ToMB(int64 Bytes) { return double(Bytes) / (1024.0 * 1024.0); }
+
+	FPluginScanOptions MakeOptions(EPluginReferencePass Pass, bool bUseCache, const FString& CachePath)
+	{
+		// só as passadas que leem o registry: código, config e módulos são do editor real
+		FPluginScanOptions Options;
+		Options.ReferencePass = Pass;
+		Options.bUseCache = bUseCache;
+		Options.CachePath = CachePath;
+		Options.bScanSource = false;
+		Options.bScanConfig = false;
+		Options.bCheckLoadedModules = false;
+		return Options;
+	}
+
+	FPluginScanResult RunOnce(const FSyntheticScanSource& Source, const FPluginScanOptions& Options)
+	{
+		FPluginScanResult Result;
+		FScanContext Ctx;
+		Ctx.Counters = &Result.Stats.Counters;
+		RunScan(Source.GetPlugins(), Options, Source, Ctx, Result);
+		return Result;
+	}
+
+	// { "<fase>": segundos, ..., "total": segundos, "memoryMB": soma dos deltas positivos }
+	TSharedRef<FJsonObject> StatsToJson(const FPluginScanStats& Stats)
+	{
+		TSharedRef<FJsonObject> Obj = MakeShared<FJsonObject>();
+		double MemoryMB = 0.0;
+		for (const FPluginScanPhaseStats& P : Stats.Phases)
+		{
+			Obj->SetNumberField(LexToString(P.Phase), P.Seconds);
+			MemoryMB += FMath::Max(0.0, ToMB(P.MemoryDeltaBytes));
+		}
+		Obj->SetNumberField(TEXT("total"), Stats.GetTotalSeconds());
+		Obj->SetNumberField(TEXT("memoryMB"), MemoryMB);
+		return Obj;
+	}
+
+	// Compara cada número de Current com o do baseline; loga e conta as regressões
+	int32 CompareStats(const FString& Label, const FJsonObject& Current, const FJsonObject& Baseline, double Tolerance)
+	{
+		int32 Regressions = 0;
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : Current.Values)
+		{
+			double Base = 0.0;
+			if (!Baseline.TryGetNumberField(Pair.Key, Base))
+				continue;
+
+			const bool bMemory = Pair.Key == TEXT("memoryMB");
+			const double Now = Pair.Value->AsNumber();
+			const double Floor = bMemory ? NoiseFloorMB : NoiseFloorSeconds;
+
+			if (Now > FMath::Max(Base, Floor) * (1.0 + Tolerance))
+			{
+				UE_LOG(LogPluginOptimizerBenchmark, Error, TEXT("%s %s: %.3f -> %.3f %s"),
+					*Label, *Pair.Key, Base, Now, bMemory ? TEXT("MB") : TEXT("s"));
+				++Regressions;
+			}
+		}
+		return Regressions;
+	}
+
+	TArray<int32> ParseSizes(const FString& Text)
+	{
+		TArray<FString> Parts;
+		Text.ParseIntoArray(Parts, TEXT(","));
+
+		TArray<int32> Sizes;
+		for (const FString& Part : Parts)
+		{
+			const int32 Size = FCString::Atoi(*Part);
+			if (Size > 0) Sizes.Add(Size);
+		}
+		return Sizes;
+	}
+
+	// Todos os campos do gerador: o baseline só vale para a mesma distribuição
+	TSharedRef<FJsonObject> SettingsToJson(const FSyntheticRegistrySettings& S)
+	{
+		TSharedRef<FJsonObject> Obj = MakeShared<FJsonObject>();
+		Obj->SetNumberField(TEXT("numAssets"), S.NumAssets);
+		Obj->SetNumberField(TEXT("assetsPerPackage"), S.AssetsPerPackage);
+		Obj->SetNumberField(TEXT("numPlugins"), S.NumPlugins);
+		Obj->SetNumberField(TEXT("assetsPerPlugin"), S.AssetsPerPlugin);
+		Obj->SetStringField(TEXT("mountPathFormat"), S.MountPathFormat);
+		Obj->SetNumberField(TEXT("pluginDependencyRatio"), S.PluginDependencyRatio);
+		Obj->SetNumberField(TEXT("classTagRatio"), S.ClassTagRatio);
+		Obj->SetNumberField(TEXT("interfaceTagRatio"), S.InterfaceTagRatio);
+		Obj->SetNumberField(TEXT("dependenciesPerPackage"), S.DependenciesPerPackage);
+		Obj->SetNumberField(TEXT("pluginContentRatio"), S.PluginContentRatio);
+		Obj->SetNumberField(TEXT("pluginSkew"), S.PluginSkew);
+		Obj->SetNumberField(TEXT("seed"), S.Seed);
+		return Obj;
+	}
+
+	// Mesmos campos com os mesmos valores (baseline antigo, sem "settings", não casa)
+	bool SameSettings(const FJsonObject& A, const TSharedPtr<FJsonObject>* B)
+	{
+		if (!B || !B->IsValid() || (*B)->Values.Num() != A.Values.Num())
+			return false;
+
+		for (const TPair<FString, TSharedPtr<FJsonValue>>& Pair : A.Values)
+		{
+			const TSharedPtr<FJsonValue> Other = (*B)->TryGetField(Pair.Key);
+			if (!Other.IsValid() || Other->Type != Pair.Value->Type)
+				return false;
+			if (Pair.Value->Type == EJson::String ? Other->AsString() != Pair.Value->AsString()
+				: !FMath::IsNearlyEqual(Other->AsNumber(), Pair.Value->AsNumber(), 1e-6))
+				return false;
+		}
+		return true;
+	}
+}
+
+UPluginOptimizerBenchmarkCommandlet::UPluginOptimizerBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UPluginOptimizerBenchmarkCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens, Switches;
+	TMap<FString, FString> ParamVals;
+	ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+	auto GetFloat = [&ParamVals](const TCHAR* Key, float Default)
+		{
+			const FString* Val = ParamVals.Find(Key);
+			return Val ? FCString::Atof(**Val) : Default;
+		};
+	auto GetInt = [&ParamVals](const TCHAR* Key, int32 Default)
+		{
+			const FString* Val = ParamVals.Find(Key);
+			return Val ? FCString::Atoi(**Val) : Default;
+		};
+
+	FSyntheticRegistrySettings Settings;
+	Settings.NumPlugins = GetInt(TEXT("Plugins"), Settings.NumPlugins);
+	Settings.AssetsPerPlugin = GetInt(TEXT("AssetsPerPlugin"), Settings.AssetsPerPlugin);
+	Settings.ClassTagRatio = GetFloat(TEXT("ClassTagRatio"), Settings.ClassTagRatio);
+	Settings.InterfaceTagRatio = GetFloat(TEXT("InterfaceTagRatio"), Settings.InterfaceTagRatio);
+	Settings.DependenciesPerPackage = GetInt(TEXT("DepsPerPackage"), Settings.DependenciesPerPackage);
+	Settings.PluginContentRatio = GetFloat(TEXT("PluginContentRatio"), Settings.PluginContentRatio);
+	Settings.Seed = GetInt(TEXT("Seed"), Settings.Seed);
+	if (const FString* Mount = ParamVals.Find(TEXT("MountPath")))
+		Settings.MountPathFormat = *Mount;
+
+	// sem {0} todos os plugins caem no mesmo mount e o resultado esperado não vale
+	if (!Settings.MountPathFormat.Contains(TEXT("{0}")))
+	{
+		UE_LOG(LogPluginOptimizerBenchmark, Error, TEXT("-MountPath '%s' must contain {0} (the plugin index)."), *Settings.MountPathFormat);
+		return 2;
+	}
+
+	const FString* SizesParam = ParamVals.Find(TEXT("Sizes"));
+	const TArray<int32> Sizes = ParseSizes(SizesParam ? *SizesParam : TEXT("10000,100000,1000000"));
+	const double Tolerance = GetFloat(TEXT("Tolerance"), 0.25f);
+
+	const FString BenchDir = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("PluginOptimizer"), TEXT("Benchmark"));
+	const FString* ReportParam = ParamVals.Find(TEXT("Report"));
+	const FString ReportPath = ReportParam ? *ReportParam : FPaths::Combine(BenchDir, TEXT("BenchmarkReport.json"));
+	const FString BaselinePath = ParamVals.FindRef(TEXT("Baseline"));
+
+	bool bConsistent = true;
+	TArray<TSharedPtr<FJsonValue>> Runs;
+
+	for (const int32 NumAssets : Sizes)
+	{
+		Settings.NumAssets = NumAssets;
+
+		// ------------------ geração ------------------
+		const uint64 MemBefore = FPlatformMemory::GetStats().UsedPhysical;
+		const double GenStart = FPlatformTime::Seconds();
+		const FSyntheticScanSource Source(Settings);
+		const double GenSeconds = FPlatformTime::Seconds() - GenStart;
+		const double GenMB = ToMB(int64(FPlatformMemory::GetStats().UsedPhysical) - int64(MemBefore));
+
+		// ------------------ a frio, cache quente e referencers ------------------
+		const FString CachePath = FPaths::Combine(BenchDir, FString::Printf(TEXT("ScanCache_%d.bin"), NumAssets));
+		IFileManager::Get().Delete(*CachePath, false, true, true);
+
+		const FPluginScanResult Cold = RunOnce(Source, MakeOptions(EPluginReferencePass::GameDependencies, false, CachePath));
+		RunOnce(Source, MakeOptions(EPluginReferencePass::GameDependencies, true, CachePath));      // preenche o cache
+		const FPluginScanResult Warm = RunOnce(Source, MakeOptions(EPluginReferencePass::GameDependencies, true, CachePath));
+		const FPluginScanResult Refs = RunOnce(Source, MakeOptions(EPluginReferencePass::PluginReferencers, false, CachePath));
+		IFileManager::Get().Delete(*CachePath, false, true, true);
+
+		if (Cold.UsedPlugins != Warm.UsedPlugins || Cold.UsedPlugins != Refs.UsedPlugins)
+		{
+			UE_LOG(LogPluginOptimizerBenchmark, Error, TEXT("%d assets: modes disagree (cold %d, warm %d, referencers %d used)."),
+				NumAssets, Cold.UsedPlugins.Num(), Warm.UsedPlugins.Num(), Refs.UsedPlugins.Num());
+			bConsistent = false;
+		}
+		if (Cold.Used != Source.GetExpectedUsed())
+		{
+			UE_LOG(LogPluginOptimizerBenchmark, Error, TEXT("%d assets: used set differs from the generated one (%d used, %d expected)."),
+				NumAssets, Cold.UsedPlugins.Num(), Source.GetExpectedUsed().CountSetBits());
+			bConsistent = false;
+		}
+
+		double AssetsSeconds = 0.0;
+		for (const FPluginScanPhaseStats& P : Cold.Stats.Phases)
+			if (P.Phase == EPluginScanPhase::GameAssets) AssetsSeconds = P.Seconds;
+
+		UE_LOG(LogPluginOptimizerBenchmark, Display,
+			TEXT("%d assets / %d packages: generate %.2fs (%.0f MB) | cold %.3fs | warm %.3fs | referencers %.3fs | %.0f assets/s | used %d/%d"),
+			NumAssets, Source.GetNumPackages(), GenSeconds, GenMB,
+			Cold.Stats.GetTotalSeconds(), Warm.Stats.GetTotalSeconds(), Refs.Stats.GetTotalSeconds(),
+			AssetsSeconds > 0.0 ? NumAssets / AssetsSeconds : 0.0, Cold.UsedPlugins.Num(), Settings.NumPlugins);
+
+		TSharedRef<FJsonObject> Run = MakeShared<FJsonObject>();
+		Run->SetNumberField(TEXT("assets"), NumAssets);
+		Run->SetNumberField(TEXT("packages"), Source.GetNumPackages());
+		Run->SetNumberField(TEXT("plugins"), Settings.NumPlugins);
+		Run->SetNumberField(TEXT("seed"), Settings.Seed);
+		Run->SetObjectField(TEXT("settings"), SettingsToJson(Settings));
+		Run->SetNumberField(TEXT("usedPlugins"), Cold.UsedPlugins.Num());
+		Run->SetNumberField(TEXT("generateSeconds"), GenSeconds);
+		Run->SetNumberField(TEXT("sourceMB"), ToMB(int64(Source.GetAllocatedSize())));
+		Run->SetNumberField(TEXT("assetsPerSecond"), AssetsSeconds > 0.0 ? NumAssets / AssetsSeconds : 0.0);
+		Run->SetObjectField(TEXT("cold"), StatsToJson(Cold.Stats));
+		Run->SetObjectField(TEXT("warm"), StatsToJson(Warm.Stats));
+		Run->SetObjectField(TEXT("referencers"), StatsToJson(Refs.Stats));
+		Runs.Add(MakeShared<FJsonValueObject>(Run));
+	}
+
+	// ------------------ relatório ------------------
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetArrayField(TEXT("runs"), Runs);
+
+	FString ReportText;
+	FJsonSerializer::Serialize(Root, TJsonWriterFactory<>::Create(&ReportText));
+	if (!FFileHelper::SaveStringToFile(ReportText, *ReportPath))
+	{
+		UE_LOG(LogPluginOptimizerBenchmark, Error, TEXT("Could not write report '%s'."), *ReportPath);
+		return 2;
+	}
+
+	if (!bConsistent)
+		return 2;
+
+	if (BaselinePath.IsEmpty())
+		return 0;
+
+	if (Switches.Contains(TEXT("UpdateBaseline")))
+		return FFileHelper::SaveStringToFile(ReportText, *BaselinePath) ? 0 : 2;
+
+	// ------------------ comparação com o baseline ------------------
+	FString BaselineText;
+	TSharedPtr<FJsonObject> Baseline;
+	if (!FFileHelper::LoadFileToString(BaselineText, *BaselinePath)
+		|| !FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(BaselineText), Baseline) || !Baseline.IsValid())
+	{
+		UE_LOG(LogPluginOptimizerBenchmark, Error, TEXT("Could not read baseline '%s'."), *BaselinePath);
+		return 2;
+	}
+
+	int32 Regressions = 0;
+	for (const TSharedPtr<FJsonValue>& RunValue : Runs)
+	{
+		const TSharedPtr<FJsonObject>& Run = RunValue->AsObject();
+		const int32 NumAssets = int32(Run->GetNumberField(TEXT("assets")));
+
+		// mesmo gerador com os mesmos parâmetros (tamanho, semente, proporções, mount)
+		const TSharedPtr<FJsonObject>& RunSettings = Run->GetObjectField(TEXT("settings"));
+		TSharedPtr<FJsonObject> Base;
+		for (const TSharedPtr<FJsonValue>& BaseValue : Baseline->GetArrayField(TEXT("runs")))
+		{
+			const TSharedPtr<FJsonObject>& Candidate = BaseValue->AsObject();
+			const TSharedPtr<FJsonObject>* CandidateSettings = nullptr;
+			if (Candidate.IsValid() && Candidate->TryGetObjectField(TEXT("settings"), CandidateSettings)
+				&& SameSettings(*RunSettings, CandidateSettings))
+			{
+				Base = Candidate;
+				break;
+			}
+		}
+
+		if (!Base.IsValid())
+		{
+			UE_LOG(LogPluginOptimizerBenchmark, Warning, TEXT("%d assets: no baseline entry."), NumAssets);
+			continue;
+		}
+
+		if (Base->GetNumberField(TEXT("usedPlugins")) != Run->GetNumberField(TEXT("usedPlugins")))
+		{
+			UE_LOG(LogPluginOptimizerBenchmark, Error, TEXT("%d assets: used plugins %d -> %d."), NumAssets,
+				int32(Base->GetNumberField(TEXT("usedPlugins"))), int32(Run->GetNumberField(TEXT("usedPlugins"))));
+			++Regressions;
+		}
+
+		for (const TCHAR* Mode : { TEXT("cold"), TEXT("warm"), TEXT("referencers") })
+		{
+			Regressions += CompareStats(FString::Printf(TEXT("%d assets %s"), NumAssets, Mode),
+				*Run->GetObjectField(Mode), *Base->GetObjectField(Mode), Tolerance);
+		}
+	}
+
+	UE_LOG(LogPluginOptimizerBenchmark, Display, TEXT("%d regression(s) against '%s' (tolerance %.0f%%)."),
+		Regressions, *BaselinePath, Tolerance * 100.0);
+	return Regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,570 @@
+#include "PluginOptimizerCommandlet.h"
+#include "PluginUsageScanner.h"
+#include "PluginScanCommon.h"
+#include "PluginBatchScanner.h"
+#include "PluginScanSnapshot.h"
+
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/App.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogPluginOptimizer, Log, All);
+
+namespace
+{
+	TArray<FString> GetCandidates(const FPluginScanResult& Result)
+	{
+		TArray<FString> Candidates;
+		for (int32 Idx = 0; Idx < Result.EnabledPlugins.Num(); ++Idx)
+		{
+			if (Result.UsageReasons[Idx] == EPluginUsageReason::None)
+				Candidates.Add(Result.EnabledPlugins[Idx]);
+		}
+		Candidates.Sort();
+		return Candidates;
+	}
+
+	// Baseline = relatório JSON de uma execução anterior
+	bool LoadBaseline(const FString& Path, TSet<FString>& OutCandidates)
+	{
+		FString Text;
+		if (!FFileHelper::LoadFileToString(Text, *Path))
+			return false;
+
+		TSharedPtr<FJsonObject> Root;
+		if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Root) || !Root.IsValid())
+			return false;
+
+		TArray<FString> Names;
+		Root->TryGetStringArrayField(TEXT("candidates"), Names);
+		OutCandidates.Append(Names);
+		return true;
+	}
+
+	FString BuildJsonReport(const FPluginScanResult& Result, const TArray<FString>& Candidates,
+		const TArray<FString>& NewCandidates, const FPluginScanDiff* Diff = nullptr)
+	{
+		TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetStringField(TEXT("project"), FApp::GetProjectName());
+
+		auto ToJsonArray = [](const TArray<FString>& Names)
+			{
+				TArray<TSharedPtr<FJsonValue>> Values;
+				for (const FString& N : Names)
+					Values.Add(MakeShared<FJsonValueString>(N));
+				return Values;
+			};
+
+		TArray<TSharedPtr<FJsonValue>> Used;
+		for (int32 Idx = 0; Idx < Result.EnabledPlugins.Num(); ++Idx)
+		{
+			if (Result.UsageReasons[Idx] == EPluginUsageReason::None)
+				continue;
+
+			TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+			Entry->SetStringField(TEXT("name"), Result.EnabledPlugins[Idx]);
+			Entry->SetStringField(TEXT("reasons"), LexToString(Result.UsageReasons[Idx]));
+			if (Result.Evidence)
+			{
+				TArray<TSharedPtr<FJsonValue>> Evidence;
+				for (const FPluginEvidence& E : Result.Evidence->Get(Idx))
+					Evidence.Add(MakeShared<FJsonValueString>(Result.Evidence->Describe(E).ToString()));
+				Entry->SetArrayField(TEXT("evidence"), Evidence);
+				Entry->SetNumberField(TEXT("hits"), Result.Evidence->GetTotalHits(Idx));
+			}
+			Used.Add(MakeShared<FJsonValueObject>(Entry));
+		}
+
+		// candidato -> plugins que saem junto com ele
+		TSharedRef<FJsonObject> Groups = MakeShared<FJsonObject>();
+		for (int32 Idx = 0; Idx < Result.EnabledPlugins.Num(); ++Idx)
+		{
+			if (Result.RemovableGroups.IsValidIndex(Idx) && Result.RemovableGroups[Idx].Num())
+				Groups->SetArrayField(Result.EnabledPlugins[Idx], ToJsonArray(Result.RemovableGroups[Idx]));
+		}
+
+		// alvo -> [{ plugin, modules: [{ name, type, phase }] }]
+		TSharedRef<FJsonObject> Targets = MakeShared<FJsonObject>();
+		for (const FPluginTargetReport& Report : Result.TargetReports)
+		{
+			TArray<TSharedPtr<FJsonValue>> Plugins;
+			for (const FPluginStrippable& S : Report.Strippable)
+			{
+				TArray<TSharedPtr<FJsonValue>> Modules;
+				for (const FPluginShippedModule& M : S.Modules)
+				{
+					TSharedRef<FJsonObject> Module = MakeShared<FJsonObject>();
+					Module->SetStringField(TEXT("name"), M.Name.ToString());
+					Module->SetStringField(TEXT("type"), EHostType::ToString(M.Type));
+					Module->SetStringField(TEXT("phase"), ELoadingPhase::ToString(M.Phase));
+					Modules.Add(MakeShared<FJsonValueObject>(Module));
+				}
+
+				TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+				Entry->SetStringField(TEXT("plugin"), S.Plugin);
+				Entry->SetArrayField(TEXT("modules"), Modules);
+				Plugins.Add(MakeShared<FJsonValueObject>(Entry));
+			}
+			Targets->SetArrayField(LexToString(Report.Target), Plugins);
+		}
+
+		TSharedRef<FJsonObject> Timings = MakeShared<FJsonObject>();
+		for (const FPluginScanPhaseStats& P : Result.Stats.Phases)
+			Timings->SetNumberField(LexToString(P.Phase), P.Seconds);
+
+		const FPluginScanCounters& C = Result.Stats.Counters;
+		TSharedRef<FJsonObject> Counters = MakeShared<FJsonObject>();
+		Counters->SetNumberField(TEXT("packagesVisited"), double(C.PackagesVisited));
+		Counters->SetNumberField(TEXT("cachedPackages"), double(C.CachedPackages));
+		Counters->SetNumberField(TEXT("assetsVisited"), double(C.AssetsVisited));
+		Counters->SetNumberField(TEXT("tagLookups"), double(C.TagLookups));
+		Counters->SetNumberField(TEXT("dependencyQueries"), double(C.DependencyQueries));
+		Counters->SetNumberField(TEXT("sourceFiles"), double(C.SourceFiles));
+		Counters->SetNumberField(TEXT("configFiles"), double(C.ConfigFiles));
+		Counters->SetNumberField(TEXT("packageHeaders"), double(C.PackageHeaders));
+		Counters->SetNumberField(TEXT("peakUsedPhysicalMB"), double(Result.Stats.PeakUsedPhysicalBytes) / (1024.0 * 1024.0));
+		if (Result.Evidence)
+			Counters->SetNumberField(TEXT("evidenceKB"), double(Result.Evidence->GetAllocatedSize()) / 1024.0);
+
+		Root->SetArrayField(TEXT("enabled"), ToJsonArray(Result.EnabledPlugins));
+		Root->SetArrayField(TEXT("used"), Used);
+		Root->SetArrayField(TEXT("candidates"), ToJsonArray(Candidates));
+		Root->SetArrayField(TEXT("newCandidates"), ToJsonArray(NewCandidates));
+		Root->SetObjectField(TEXT("removableGroups"), Groups);
+		Root->SetObjectField(TEXT("strippableByTarget"), Targets);
+		if (Result.TargetReports.Num())
+			Root->SetStringField(TEXT("targetPlatform"), Result.TargetReports[0].Platform);
+		Root->SetObjectField(TEXT("timings"), Timings);
+		Root->SetObjectField(TEXT("counters"), Counters);
+
+		if (Diff)
+		{
+			TSharedRef<FJsonObject> DiffJson = MakeShared<FJsonObject>();
+			DiffJson->SetArrayField(TEXT("newlyUsed"), ToJsonArray(Diff->NewlyUsed));
+			DiffJson->SetArrayField(TEXT("newlyUnused"), ToJsonArray(Diff->NewlyUnused));
+			DiffJson->SetArrayField(TEXT("added"), ToJsonArray(Diff->Added));
+			DiffJson->SetArrayField(TEXT("removed"), ToJsonArray(Diff->Removed));
+			Root->SetObjectField(TEXT("diff"), DiffJson);
+		}
+
+		FString Out;
+		FJsonSerializer::Serialize(Root, TJsonWriterFactory<>::Create(&Out));
+		return Out;
+	}
+
+	// { projects: [...], crossProject: { unusedEverywhere, candidateIn } }
+	FString BuildBatchReport(const TArray<FPluginBatchProject>& Projects)
+	{
+		auto ToJsonArray = [](const TArray<FString>& Names)
+			{
+				TArray<TSharedPtr<FJsonValue>> Values;
+				for (const FString& N : Names)
+					Values.Add(MakeShared<FJsonValueString>(N));
+				return Values;
+			};
+
+		// plugin -> projetos que o habilitam / em que ele é candidato
+		TMap<FString, TArray<FString>> EnabledIn, CandidateIn;
+
+		TArray<TSharedPtr<FJsonValue>> PerProject;
+		for (const FPluginBatchProject& P : Projects)
+		{
+			const FString Name = FPaths::GetBaseFilename(P.ProjectFile);
+			TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+			Entry->SetStringField(TEXT("project"), P.ProjectFile);
+			Entry->SetStringField(TEXT("registry"), P.RegistryPath);
+			if (!P.Error.IsEmpty())
+			{
+				Entry->SetStringField(TEXT("error"), P.Error);
+				PerProject.Add(MakeShared<FJsonValueObject>(Entry));
+				continue;
+			}
+
+			const TArray<FString> Candidates = GetCandidates(P.Result);
+			for (const FString& Plugin : P.Result.EnabledPlugins) EnabledIn.FindOrAdd(Plugin).Add(Name);
+			for (const FString& Plugin : Candidates)              CandidateIn.FindOrAdd(Plugin).Add(Name);
+
+			Entry->SetNumberField(TEXT("enabled"), P.Result.EnabledPlugins.Num());
+			Entry->SetArrayField(TEXT("used"), ToJsonArray(P.Result.UsedPlugins));
+			Entry->SetArrayField(TEXT("candidates"), ToJsonArray(Candidates));
+			Entry->SetNumberField(TEXT("seconds"), P.Result.Stats.GetTotalSeconds());
+			PerProject.Add(MakeShared<FJsonValueObject>(Entry));
+		}
+
+		// sem uso em todo projeto que habilita o plugin
+		TArray<FString> UnusedEverywhere;
+		TSharedRef<FJsonObject> CandidateInJson = MakeShared<FJsonObject>();
+		for (TPair<FString, TArray<FString>>& Pair : CandidateIn)
+		{
+			if (Pair.Value.Num() == EnabledIn.FindChecked(Pair.Key).Num())
+				UnusedEverywhere.Add(Pair.Key);
+			Pair.Value.Sort();
+			CandidateInJson->SetArrayField(Pair.Key, ToJsonArray(Pair.Value));
+		}
+		UnusedEverywhere.Sort();
+
+		TSharedRef<FJsonObject> Cross = MakeShared<FJsonObject>();
+		Cross->SetArrayField(TEXT("unusedEverywhere"), ToJsonArray(UnusedEverywhere));
+		Cross->SetObjectField(TEXT("candidateIn"), CandidateInJson);
+
+		TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetArrayField(TEXT("projects"), PerProject);
+		Root->SetObjectField(TEXT("crossProject"), Cross);
+
+		FString Out;
+		FJsonSerializer::Serialize(Root, TJsonWriterFactory<>::Create(&Out));
+		return Out;
+	}
+
+	// -Projects=<A.uproject>[,<registry>]+<B.uproject>...
+	int32 RunBatch(const FString& ProjectsParam, const TMap<FString, FString>& ParamVals, const FPluginScanOptions& Options)
+	{
+		TArray<FPluginBatchProject> Projects;
+		TArray<FString> Entries;
+		ProjectsParam.ParseIntoArray(Entries, TEXT("+"));
+		for (const FString& E : Entries)
+		{
+			FPluginBatchProject& P = Projects.AddDefaulted_GetRef();
+			if (!E.Split(TEXT(","), &P.ProjectFile, &P.RegistryPath))
+				P.ProjectFile = E;
+			P.ProjectFile = FPaths::ConvertRelativePathToFull(P.ProjectFile);
+		}
+
+		const FString* ReportParam = ParamVals.Find(TEXT("Report"));
+		const FString ReportPath = ReportParam ? *ReportParam
+			: FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("PluginOptimizer"), TEXT("BatchReport.json"));
+		const FString* MaxParam = ParamVals.Find(TEXT("MaxParallel"));
+		const int32 MaxParallel = MaxParam ? FCString::Atoi(**MaxParam) : 4;
+
+		FPluginBatchScanner Batch;
+		Batch.Run(Projects, Options, MaxParallel);
+
+		if (!FFileHelper::SaveStringToFile(BuildBatchReport(Projects), *ReportPath))
+		{
+			UE_LOG(LogPluginOptimizer, Error, TEXT("Could not write report '%s'."), *ReportPath);
+			return 2;
+		}
+
+		bool bAnyError = false;
+		for (const FPluginBatchProject& P : Projects)
+		{
+			if (!P.Error.IsEmpty())
+			{
+				UE_LOG(LogPluginOptimizer, Error, TEXT("%s: %s"), *P.ProjectFile, *P.Error);
+				bAnyError = true;
+				continue;
+			}
+			UE_LOG(LogPluginOptimizer, Display, TEXT("%s: Enabled: %d | Used: %d | Potentially Unused: %d (%.2fs)"),
+				*FPaths::GetBaseFilename(P.ProjectFile), P.Result.EnabledPlugins.Num(), P.Result.UsedPlugins.Num(),
+				P.Result.EnabledPlugins.Num() - P.Result.UsedPlugins.Num(), P.Result.Stats.GetTotalSeconds());
+		}
+		return bAnyError ? 2 : 0;
+	}
+
+	// CSV: map,<plugin>... com 0/1 (só colunas alcançadas por algum mapa).
+	// JSON: { plugins: [{ name, maps }], maps: { <mapa>: [plugins] }, stats }
+	FString BuildMapMatrixReport(const FPluginMapReachability& R, bool bCsv)
+	{
+		TArray<int32> Columns;
+		for (int32 Idx = 0; Idx < R.Plugins.Num(); ++Idx)
+			if (R.GetNumMapsReaching(Idx) > 0)
+				Columns.Add(Idx);
+
+		if (bCsv)
+		{
+			FString Out = TEXT("map");
+			for (const int32 Idx : Columns)
+				Out += TEXT(",") + R.Plugins[Idx];
+			Out += TEXT("\n");
+			for (int32 MapIdx = 0; MapIdx < R.Maps.Num(); ++MapIdx)
+			{
+				Out += R.Maps[MapIdx].ToString();
+				for (const int32 Idx : Columns)
+					Out += R.Reached[MapIdx][Idx] ? TEXT(",1") : TEXT(",0");
+				Out += TEXT("\n");
+			}
+			return Out;
+		}
+
+		TArray<TSharedPtr<FJsonValue>> PluginsJson;
+		for (const int32 Idx : Columns)
+		{
+			TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+			Entry->SetStringField(TEXT("name"), R.Plugins[Idx]);
+			Entry->SetNumberField(TEXT("maps"), R.GetNumMapsReaching(Idx));
+			PluginsJson.Add(MakeShared<FJsonValueObject>(Entry));
+		}
+
+		TSharedRef<FJsonObject> MapsJson = MakeShared<FJsonObject>();
+		for (int32 MapIdx = 0; MapIdx < R.Maps.Num(); ++MapIdx)
+		{
+			TArray<TSharedPtr<FJsonValue>> Reached;
+			for (TConstSetBitIterator<> It(R.Reached[MapIdx]); It; ++It)
+				Reached.Add(MakeShared<FJsonValueString>(R.Plugins[It.GetIndex()]));
+			MapsJson->SetArrayField(R.Maps[MapIdx].ToString(), Reached);
+		}
+
+		TSharedRef<FJsonObject> Stats = MakeShared<FJsonObject>();
+		Stats->SetNumberField(TEXT("packages"), R.NumPackages);
+		Stats->SetNumberField(TEXT("components"), R.NumComponents);
+		Stats->SetNumberField(TEXT("distinctSets"), R.NumDistinctSets);
+		Stats->SetNumberField(TEXT("dependencyQueries"), double(R.DependencyQueries));
+		Stats->SetNumberField(TEXT("seconds"), R.Seconds);
+
+		TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+		Root->SetStringField(TEXT("project"), FApp::GetProjectName());
+		Root->SetArrayField(TEXT("plugins"), PluginsJson);
+		Root->SetObjectField(TEXT("maps"), MapsJson);
+		Root->SetObjectField(TEXT("stats"), Stats);
+
+		FString Out;
+		FJsonSerializer::Serialize(Root, TJsonWriterFactory<>::Create(&Out));
+		return Out;
+	}
+
+	// -MapMatrix=<arquivo.csv|.json> [-AssetRegistry=<AssetRegistry.bin>]
+	int32 RunMapMatrix(const FString& MatrixPath, const TMap<FString, FString>& ParamVals, const FPluginScanOptions& Options)
+	{
+		const FString RegistryPath = ParamVals.FindRef(TEXT("AssetRegistry"));
+		if (RegistryPath.IsEmpty())
+			PluginScan::GetAssetRegistry().SearchAllAssets(true);
+
+		FPluginMapReachability Result;
+		if (!FPluginUsageScanner::ScanMapReachability(Result, RegistryPath, Options))
+		{
+			UE_LOG(LogPluginOptimizer, Error, TEXT("Could not read asset registry '%s'."), *RegistryPath);
+			return 2;
+		}
+
+		const bool bCsv = FPaths::GetExtension(MatrixPath).Equals(TEXT("csv"), ESearchCase::IgnoreCase);
+		if (!FFileHelper::SaveStringToFile(BuildMapMatrixReport(Result, bCsv), *MatrixPath))
+		{
+			UE_LOG(LogPluginOptimizer, Error, TEXT("Could not write report '%s'."), *MatrixPath);
+			return 2;
+		}
+
+		// no chunk base só faz sentido o que todo mapa puxa
+		TArray<FString> InEveryMap;
+		int32 NumReached = 0;
+		for (int32 Idx = 0; Idx < Result.Plugins.Num(); ++Idx)
+		{
+			const int32 NumMaps = Result.GetNumMapsReaching(Idx);
+			NumReached += NumMaps > 0 ? 1 : 0;
+			if (NumMaps > 0 && NumMaps == Result.Maps.Num())
+				InEveryMap.Add(Result.Plugins[Idx]);
+		}
+
+		UE_LOG(LogPluginOptimizer, Display, TEXT("Maps: %d | Plugins reached by some map: %d | by every map: %d"),
+			Result.Maps.Num(), NumReached, InEveryMap.Num());
+		UE_LOG(LogPluginOptimizer, Display, TEXT("Packages: %d | Components: %d | Distinct plugin sets: %d | Dependency queries: %lld (%.2fs)"),
+			Result.NumPackages, Result.NumComponents, Result.NumDistinctSets, Result.DependencyQueries, Result.Seconds);
+		if (InEveryMap.Num())
+			UE_LOG(LogPluginOptimizer, Display, TEXT("Reached by every map: %s"), *FString::Join(InEveryMap, TEXT(", ")));
+		return 0;
+	}
+
+	// plugin,status,reasons
+	FString BuildCsvReport(const FPluginScanResult& Result, const TSet<FString>& NewCandidates)
+	{
+		FString Out = TEXT("plugin,status,reasons\n");
+		for (int32 Idx = 0; Idx < Result.EnabledPlugins.Num(); ++Idx)
+		{
+			const FString& Name = Result.EnabledPlugins[Idx];
+			const EPluginUsageReason Reasons = Result.UsageReasons[Idx];
+
+			const TCHAR* Status = Reasons != EPluginUsageReason::None ? TEXT("used")
+				: NewCandidates.Contains(Name) ? TEXT("new-candidate") : TEXT("candidate");
+			Out += FString::Printf(TEXT("%s,%s,%s\n"), *Name, Status, *LexToString(Reasons));
+		}
+		return Out;
+	}
+
+	// target,plugin,modules (módulos separados por '|'); arquivo à parte para
+	// o CSV principal manter um único formato de linha
+	FString BuildTargetsCsvReport(const FPluginScanResult& Result)
+	{
+		FString Out = TEXT("target,plugin,modules\n");
+		for (const FPluginTargetReport& Report : Result.TargetReports)
+		{
+			for (const FPluginStrippable& S : Report.Strippable)
+			{
+				TArray<FString> Modules;
+				for (const FPluginShippedModule& M : S.Modules)
+					Modules.Add(M.Name.ToString());
+				Out += FString::Printf(TEXT("%s,%s,%s\n"), LexToString(Report.Target), *S.Plugin, *FString::Join(Modules, TEXT("|")));
+			}
+		}
+		return Out;
+	}
+}
+
+UPluginOptimizerCommandlet::UPluginOptimizerCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UPluginOptimizerCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens, Switches;
+	TMap<FString, FString> ParamVals;
+	ParseCommandLine(*Params, Tokens, Switches, ParamVals);
+
+	const FString* ReportParam = ParamVals.Find(TEXT("Report"));
+	const FString ReportPath = ReportParam ? *ReportParam
+		: FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("PluginOptimizer"), TEXT("PluginReport.json"));
+	const FString BaselinePath = ParamVals.FindRef(TEXT("Baseline"));
+
+	FPluginScanOptions Options;
+	Options.bUseCache = !Switches.Contains(TEXT("NoCache"));
+	Options.bScanSource = !Switches.Contains(TEXT("SkipSource"));
+	Options.bScanConfig = !Switches.Contains(TEXT("SkipConfig"));
+	Options.bCheckLoadedModules = !Switches.Contains(TEXT("SkipLoadedModules"));
+	Options.bLightweightExternalActors = !Switches.Contains(TEXT("FullExternalActors"));
+	Options.bScanPackageImports = Switches.Contains(TEXT("DeepImports"));
+	if (const FString* BatchParam = ParamVals.Find(TEXT("BatchSize")))
+		Options.AssetBatchSize = FMath::Max(1, FCString::Atoi(**BatchParam));
+	if (ParamVals.FindRef(TEXT("ReferencePass")) == TEXT("Referencers"))
+		Options.ReferencePass = EPluginReferencePass::PluginReferencers;
+	Options.TargetPlatform = ParamVals.FindRef(TEXT("TargetPlatform"));
+
+	const FString MatrixParam = ParamVals.FindRef(TEXT("MapMatrix"));
+	if (!MatrixParam.IsEmpty())
+		return RunMapMatrix(MatrixParam, ParamVals, Options);
+
+	const FString ProjectsParam = ParamVals.FindRef(TEXT("Projects"));
+	if (!ProjectsParam.IsEmpty())
+		return RunBatch(ProjectsParam, ParamVals, Options);
+
+	// -Query=A,B: só confirma esses plugins (para no primeiro hit de cada); 1 se algum não é usado
+	const FString QueryParam = ParamVals.FindRef(TEXT("Query"));
+	if (!QueryParam.IsEmpty())
+	{
+		TArray<FString> Names;
+		QueryParam.ParseIntoArray(Names, TEXT(","));
+
+		PluginScan::GetAssetRegistry().SearchAllAssets(true);
+		FPluginScanResult Result;
+		FPluginUsageScanner::QueryPlugins(Names, Result, Options);
+
+		int32 NumUnused = 0;
+		for (const FString& Name : Names)
+		{
+			const int32 Idx = Result.EnabledPlugins.IndexOfByKey(Name);
+			if (Idx == INDEX_NONE)
+				UE_LOG(LogPluginOptimizer, Warning, TEXT("%s: not enabled"), *Name);
+			else if (Result.Used[Idx])
+				UE_LOG(LogPluginOptimizer, Display, TEXT("%s: used (%s)"), *Name, *LexToString(Result.UsageReasons[Idx]));
+			else
+			{
+				UE_LOG(LogPluginOptimizer, Display, TEXT("%s: unused"), *Name);
+				++NumUnused;
+			}
+		}
+		UE_LOG(LogPluginOptimizer, Display, TEXT("Scan statistics:\n%s"), *Result.Stats.ToString());
+		return NumUnused > 0 ? 1 : 0;
+	}
+
+	FPluginScanResult Result;
+	const FString RegistryPath = ParamVals.FindRef(TEXT("AssetRegistry"));
+	if (!RegistryPath.IsEmpty())
+	{
+		if (!FPluginUsageScanner::ScanRegistryFile(RegistryPath, Result, Options))
+		{
+			UE_LOG(LogPluginOptimizer, Error, TEXT("Could not read asset registry '%s'."), *RegistryPath);
+			return 2;
+		}
+	}
+	else
+	{
+		// commandlets não disparam a coleta do AssetRegistry sozinhos
+		PluginScan::GetAssetRegistry().SearchAllAssets(true);
+		FPluginUsageScanner::Scan(Result, Options);
+	}
+
+	const TArray<FString> Candidates = GetCandidates(Result);
+
+	// ------------------ comparação com o baseline ------------------
+	TArray<FString> NewCandidates;
+	if (!BaselinePath.IsEmpty())
+	{
+		TSet<FString> Baseline;
+		if (LoadBaseline(BaselinePath, Baseline))
+		{
+			for (const FString& Name : Candidates)
+				if (!Baseline.Contains(Name))
+					NewCandidates.Add(Name);
+		}
+		else if (!Switches.Contains(TEXT("UpdateBaseline")))
+		{
+			UE_LOG(LogPluginOptimizer, Error, TEXT("Could not read baseline '%s'."), *BaselinePath);
+			return 2;
+		}
+	}
+
+	// ------------------ snapshots (diff por scan / branch / commit) ------
+	// -DiffAgainst=<label ou .snap>  -SaveSnapshot=<label>
+	TOptional<FPluginScanDiff> Diff;
+	const FPluginScanSnapshot Current = FPluginScanSnapshot::FromResult(Result, ParamVals.FindRef(TEXT("SaveSnapshot")));
+	if (const FString* Against = ParamVals.Find(TEXT("DiffAgainst")))
+	{
+		const FString SnapPath = Against->EndsWith(TEXT(".snap")) ? *Against : FPluginScanSnapshot::GetSnapshotPath(*Against);
+		FPluginScanSnapshot Previous;
+		if (!Previous.Load(SnapPath))
+		{
+			UE_LOG(LogPluginOptimizer, Error, TEXT("Could not read snapshot '%s'."), *SnapPath);
+			return 2;
+		}
+		Diff = FPluginScanDiff::Compute(Previous, Current);
+		UE_LOG(LogPluginOptimizer, Display, TEXT("Changes since '%s':\n%s"), *Previous.Label, *Diff->ToString());
+	}
+	if (!Current.Label.IsEmpty() && !Current.Save(FPluginScanSnapshot::GetSnapshotPath(Current.Label)))
+	{
+		UE_LOG(LogPluginOptimizer, Error, TEXT("Could not write snapshot '%s'."), *Current.Label);
+		return 2;
+	}
+
+	// ------------------ relatório ------------------
+	const bool bCsv = FPaths::GetExtension(ReportPath).Equals(TEXT("csv"), ESearchCase::IgnoreCase);
+	const FString Report = bCsv
+		? BuildCsvReport(Result, TSet<FString>(NewCandidates))
+		: BuildJsonReport(Result, Candidates, NewCandidates, Diff.GetPtrOrNull());
+
+	if (!FFileHelper::SaveStringToFile(Report, *ReportPath))
+	{
+		UE_LOG(LogPluginOptimizer, Error, TEXT("Could not write report '%s'."), *ReportPath);
+		return 2;
+	}
+	if (bCsv)
+	{
+		const FString TargetsPath = FPaths::ChangeExtension(ReportPath, TEXT("targets.csv"));
+		if (!FFileHelper::SaveStringToFile(BuildTargetsCsvReport(Result), *TargetsPath))
+		{
+			UE_LOG(LogPluginOptimizer, Error, TEXT("Could not write report '%s'."), *TargetsPath);
+			return 2;
+		}
+	}
+
+	if (Switches.Contains(TEXT("UpdateBaseline")) && !BaselinePath.IsEmpty())
+	{
+		const FString Baseline = bCsv ? BuildJsonReport(Result, Candidates, NewCandidates) : Report;
+		FFileHelper::SaveStringToFile(Baseline, *BaselinePath);
+	}
+
+	UE_LOG(LogPluginOptimizer, Display, TEXT("Enabled: %d | Used: %d | Potentially Unused: %d | New: %d"),
+		Result.EnabledPlugins.Num(), Result.UsedPlugins.Num(), Candidates.Num(), NewCandidates.Num());
+	for (const FPluginTargetReport& Report : Result.TargetReports)
+		UE_LOG(LogPluginOptimizer, Display, TEXT("%s target (%s, Shipping): %d plugin(s) ship modules nothing in the project needs at runtime"),
+			LexToString(Report.Target), *Report.Platform, Report.Strippable.Num());
+	UE_LOG(LogPluginOptimizer, Display, TEXT("Scan statistics:\n%s"), *Result.Stats.ToString());
+	for (const FString& Name : NewCandidates)
+		UE_LOG(LogPluginOptimizer, Warning, TEXT("New unused plugin: %s"), *Name);
+
+	return (NewCandidates.Num() > 0 && !Switches.Contains(TEXT("UpdateBaseline"))) ? 1 : 0;
+}
@@ -1,7 +1,11 @@
 #include "PluginOptimizerModule.h"
 #include "PluginOptimizerCommands.h"
 #include "PluginUsageScanner.h"
+#include "PluginUsageTracker.h"
 #include "SPluginOptimizerDialog.h"
+#include "PluginStartupProfile.h"
+#include "PluginScanSnapshot.h"
+#include "PluginDiskSizeEstimator.h"
 
 #include "ToolMenus.h"
 #include "LevelEditor.h"
@@ -10,9 +14,13 @@
 
 #include "Widgets/SWindow.h"
 #include "Framework/Application/SlateApplication.h"
+#include "Misc/ConfigCacheIni.h"
 
 #define LOCTEXT_NAMESPACE "FPluginOptimizerModule"
 
+static const TCHAR* CFG_SECTION = TEXT("PluginOptimizer");
+static const TCHAR* CFG_LIVE_KEY = TEXT("LiveTracking");
+
 void FPluginOptimizerModule::StartupModule()
 {
 	FPluginOptimizerCommands::Register();
@@ -24,10 +32,18 @@ void FPluginOptimizerModule::StartupModule()
 
 	UToolMenus::RegisterStartupCallback(
 		FSimpleMulticastDelegate::FDelegate::CreateRaw(this, &FPluginOptimizerModule::RegisterMenus));
+
+	bool bLive = false;
+	GConfig->GetBool(CFG_SECTION, CFG_LIVE_KEY, bLive, GEditorPerProjectIni);
+	if (bLive)
+		SetLiveTracking(true);
 }
 
 void FPluginOptimizerModule::ShutdownModule()
 {
+	CancelActiveScan();
+	UsageTracker.Reset();
+
 	UToolMenus::UnRegisterStartupCallback(this);
 	UToolMenus::UnregisterOwner(this);
 
@@ -66,32 +82,155 @@ void FPluginOptimizerModule::AddToolbarEntry(UToolMenu* Toolbar)
 /* ---------------- comando principal ---------------- */
 void FPluginOptimizerModule::OnDetectUnusedPlugins()
 {
-	FPluginScanResult Result;
-	FPluginUsageScanner::Scan(Result);
+	/* scan já rodando: só traz a janela pra frente */
+	if (ActiveScan.IsValid() && !ActiveScan->IsFinished())
+	{
+		if (TSharedPtr<SWindow> Win = ActiveWindow.Pin())
+			Win->BringToFront();
+		return;
+	}
+
+	/* live tracking pronto: o resultado já está em memória */
+	const bool bUseTracker = UsageTracker.IsValid() && UsageTracker->IsReady();
+
+	/* cria janela (em modo "scanning" se precisar rodar o scan) */
+	TSharedRef<SWindow> Win = SNew(SWindow)
+		.Title(LOCTEXT("PluginOptimizerTitle", "Plugin Optimizer"))
+		.ClientSize(FVector2D(700, 500));
+
+	TSharedRef<SPluginOptimizerDialog> Dialog = SNew(SPluginOptimizerDialog)
+		.IsScanning(!bUseTracker)
+		.LiveTracking(UsageTracker.IsValid())
+		.OnLiveTrackingChanged_Raw(this, &FPluginOptimizerModule::SetLiveTracking)
+		.OnCancelScan_Lambda([this]()
+			{
+				CancelActiveScan();
+				if (TSharedPtr<SWindow> W = ActiveWindow.Pin())
+					W->RequestDestroyWindow();
+			});
+
+	/* custo de startup medido pelo PluginOptimizerProfiler (sessão anterior ou esta) */
+	FPluginStartupProfile Profile;
+	if (Profile.Load())
+		Dialog->SetStartupCosts(Profile.Plugins);
+
+	/* tamanho em disco: pastas sem mudança desde a última janela vêm do cache */
+	TWeakPtr<SPluginOptimizerDialog> WeakSizesDialog = Dialog;
+	FPluginDiskSizeEstimator::EstimateAsync([WeakSizesDialog](TMap<FString, FPluginDiskSize>&& Sizes)
+		{
+			if (TSharedPtr<SPluginOptimizerDialog> D = WeakSizesDialog.Pin())
+				D->SetDiskSizes(Sizes);
+		});
+
+	Win->SetContent(Dialog);
+	Win->SetOnWindowClosed(FOnWindowClosed::CreateLambda([this](const TSharedRef<SWindow>&)
+		{
+			CancelActiveScan();
+		}));
+
+	ActiveWindow = Win;
+	ActiveDialog = Dialog;
+
+	FSlateApplication::Get().AddWindow(Win);
+
+	if (bUseTracker)
+	{
+		OnTrackedUsageChanged();
+		return;
+	}
+
+	TWeakPtr<SPluginOptimizerDialog> WeakDialog = Dialog;
+	ActiveScan = FPluginUsageScanner::ScanAsync(
+		FOnPluginScanProgress::CreateLambda([WeakDialog](const FPluginScanProgress& Progress)
+			{
+				if (TSharedPtr<SPluginOptimizerDialog> D = WeakDialog.Pin())
+					D->SetScanProgress(Progress);
+			}),
+		FOnPluginScanComplete::CreateRaw(this, &FPluginOptimizerModule::OnScanComplete));
+}
+
+void FPluginOptimizerModule::CancelActiveScan()
+{
+	if (ActiveScan.IsValid())
+		ActiveScan->Cancel();
+	ActiveScan.Reset();
+}
 
-	TSet<FString> Enabled(Result.EnabledPlugins);
-	TSet<FString> Used(Result.UsedPlugins);
+void FPluginOptimizerModule::OnScanComplete(const FPluginScanResult& Result)
+{
+	ActiveScan.Reset();
+	ShowResult(Result);
+
+	/* diff com o scan anterior; o atual vira a base do próximo */
+	const FPluginScanSnapshot Current = FPluginScanSnapshot::FromResult(Result, FPluginScanSnapshot::LatestLabel);
+	const FString LatestPath = FPluginScanSnapshot::GetSnapshotPath(FPluginScanSnapshot::LatestLabel);
+
+	FPluginScanSnapshot Previous;
+	if (Previous.Load(LatestPath))
+	{
+		if (TSharedPtr<SPluginOptimizerDialog> Dialog = ActiveDialog.Pin())
+			Dialog->SetScanDiff(FPluginScanDiff::Compute(Previous, Current), Previous.Timestamp);
+	}
+	Current.Save(LatestPath);
+}
+
+void FPluginOptimizerModule::ShowResult(const FPluginScanResult& Result)
+{
+	TSharedPtr<SPluginOptimizerDialog> Dialog = ActiveDialog.Pin();
+	if (!Dialog.IsValid())
+		return;
 
 	TArray<FString> Candidates;
-	for (const FString& Name : Enabled)
-		if (!Used.Contains(Name))
-			Candidates.Add(Name);
+	TMap<FString, TArray<FString>> RemovableWith;
+	for (int32 Idx = 0; Idx < Result.EnabledPlugins.Num(); ++Idx)
+	{
+		const FString& Name = Result.EnabledPlugins[Idx];
+		if (Result.Used[Idx])
+			continue;
+
+		Candidates.Add(Name);
+		if (Result.RemovableGroups.IsValidIndex(Idx) && Result.RemovableGroups[Idx].Num())
+			RemovableWith.Add(Name, Result.RemovableGroups[Idx]);
+	}
 
 	Candidates.Sort();
 
-	/* cria janela */
-	TSharedRef<SWindow> Win = SNew(SWindow)
-		.Title(LOCTEXT("PluginOptimizerTitle", "Plugin Optimizer"))
-		.ClientSize(FVector2D(700, 500));
+	Dialog->SetScanResult(Candidates, Result.EnabledPlugins.Num(), Result.UsedPlugins.Num(), RemovableWith);
+	Dialog->SetUsedPlugins(Result);
 
-	Win->SetContent(
-		SNew(SPluginOptimizerDialog)
-		.Candidates(Candidates)
-		.EnabledCount(Enabled.Num())
-		.UsedCount(Used.Num())
-	);
+	/* resultados do live tracking não têm fases: mantém as do último scan */
+	if (Result.Stats.Phases.Num())
+		Dialog->SetScanStats(Result.Stats);
+}
 
-	FSlateApplication::Get().AddWindow(Win);
+/* ---------------- live tracking ---------------- */
+void FPluginOptimizerModule::SetLiveTracking(bool bEnable)
+{
+	GConfig->SetBool(CFG_SECTION, CFG_LIVE_KEY, bEnable, GEditorPerProjectIni);
+
+	if (!bEnable)
+	{
+		UsageTracker.Reset();
+		return;
+	}
+
+	if (!UsageTracker.IsValid())
+	{
+		UsageTracker = MakeShared<FPluginUsageTracker>();
+		UsageTracker->OnUsageChanged().AddRaw(this, &FPluginOptimizerModule::OnTrackedUsageChanged);
+		UsageTracker->Start();
+	}
+}
+
+void FPluginOptimizerModule::OnTrackedUsageChanged()
+{
+	/* um scan completo em andamento tem prioridade */
+	if (ActiveScan.IsValid() || !UsageTracker.IsValid() || !UsageTracker->IsReady())
+		return;
+
+	FPluginScanResult Result;
+	UsageTracker->GetResult(Result);
+	ShowResult(Result);
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,208 @@
+#include "PluginPackageImports.h"
+
+#include "Async/AsyncFileHandle.h"
+#include "HAL/PlatformFileManager.h"
+#include "Serialization/MemoryReader.h"
+#include "UObject/ObjectMacros.h"
+#include "UObject/ObjectResource.h"
+#include "UObject/PackageFileSummary.h"
+
+namespace PluginScan
+{
+	namespace
+	{
+		// Primeira leitura de cada arquivo: cobre o header da maioria dos pacotes
+		constexpr int64 InitialHeaderRead = 64 * 1024;
+
+		// Headers maiores que isso são tratados como arquivo corrompido
+		constexpr int64 MaxHeaderSize = 64 * 1024 * 1024;
+
+		template <typename CharType>
+		FName ToImportName(const CharType* Name)
+		{
+			// só "/Script/..." e a classe "Package" interessam; o resto vira None
+			if (TCString<CharType>::Strncmp(Name, CHARTEXT(CharType, "/Script/"), 8) == 0)
+				return FName(Name);
+			if (TCString<CharType>::Strcmp(Name, CHARTEXT(CharType, "Package")) == 0)
+				return NAME_Package;
+			return NAME_None;
+		}
+
+		// Resolve FNames pelo name map do próprio pacote (como o linker faz)
+		class FImportTableReader final : public FMemoryReaderView
+		{
+		public:
+			explicit FImportTableReader(TConstArrayView<uint8> Bytes) : FMemoryReaderView(Bytes) {}
+
+			bool ReadNameMap(int64 Offset, int32 Count)
+			{
+				if (Offset < 0 || Offset > TotalSize() || Count < 0 || Count > TotalSize())
+					return false;
+
+				Seek(Offset);
+				NameMap.Reset(Count);
+				FNameEntrySerialized Entry(ENAME_LinkerConstructor);
+				for (int32 Idx = 0; Idx < Count && !IsError(); ++Idx)
+				{
+					*this << Entry;
+					NameMap.Add(Entry.bIsWide ? ToImportName(Entry.WideName) : ToImportName(Entry.AnsiName));
+				}
+				return !IsError();
+			}
+
+			virtual FArchive& operator<<(FName& Name) override
+			{
+				int32 Index = 0, Number = 0;
+				*this << Index << Number;
+				if (NameMap.IsValidIndex(Index))
+				{
+					Name = NameMap[Index];
+				}
+				else
+				{
+					Name = NAME_None;
+					SetError();
+				}
+				return *this;
+			}
+
+			virtual FString GetArchiveName() const override { return TEXT("FImportTableReader"); }
+
+		private:
+			TArray<FName> NameMap;
+		};
+
+		struct FPendingRead
+		{
+			TUniquePtr<IAsyncReadFileHandle> Handle;
+			IAsyncReadRequest* Request = nullptr;
+			TArray<uint8> Header;
+			int64 FileSize = -1;
+		};
+
+		// Espera e descarta o request; o buffer é nosso (UserSuppliedMemory)
+		bool FinishRead(IAsyncReadRequest*& Request)
+		{
+			Request->WaitCompletion();
+			const bool bOk = Request->GetReadResults() != nullptr;
+			delete Request;
+			Request = nullptr;
+			return bOk;
+		}
+	}
+
+	bool ReadScriptImports(TConstArrayView<uint8> Header, TArray<FName>& OutScriptPackages, int64& OutHeaderSize)
+	{
+		OutHeaderSize = 0;
+
+		FImportTableReader Ar(Header);
+		FPackageFileSummary Summary;
+		Ar << Summary;
+		if (Ar.IsError() || Summary.Tag != PACKAGE_FILE_TAG)
+			return false;
+
+		OutHeaderSize = Summary.TotalHeaderSize;
+		if (Summary.TotalHeaderSize > Header.Num())
+			return false;
+
+		// as tabelas dependem das versões com que o pacote foi salvo
+		Ar.SetUEVer(Summary.GetFileVersionUE());
+		Ar.SetLicenseeUEVer(Summary.GetFileVersionLicenseeUE());
+		Ar.SetEngineVer(Summary.SavedByEngineVersion);
+		Ar.SetCustomVersions(Summary.GetCustomVersionContainer());
+		Ar.SetFilterEditorOnly((Summary.GetPackageFlags() & PKG_FilterEditorOnly) != 0);
+
+		if (!Ar.ReadNameMap(Summary.NameOffset, Summary.NameCount))
+			return false;
+		if (Summary.ImportOffset < 0 || Summary.ImportOffset > Header.Num())
+			return false;
+
+		Ar.Seek(Summary.ImportOffset);
+		FObjectImport Import;
+		for (int32 Idx = 0; Idx < Summary.ImportCount; ++Idx)
+		{
+			Ar << Import;
+			if (Ar.IsError())
+				return false;
+			if (Import.ClassName == NAME_Package && !Import.ObjectName.IsNone())
+				OutScriptPackages.Add(Import.ObjectName);
+		}
+		return true;
+	}
+
+	void ReadPackageImports(TConstArrayView<FString> BasePaths,
+		TFunctionRef<void(int32, TConstArrayView<FName>)> Visit)
+	{
+		IPlatformFile& PF = FPlatformFileManager::Get().GetPlatformFile();
+
+		TArray<FPendingRead> Reads;
+		Reads.SetNum(BasePaths.Num());
+
+		auto RequestSize = [&PF](FPendingRead& R, const FString& Path)
+			{
+				R.Handle.Reset(PF.OpenAsyncRead(*Path));
+				R.Request = R.Handle ? R.Handle->SizeRequest() : nullptr;
+			};
+		auto WaitSize = [](FPendingRead& R)
+			{
+				if (!R.Request) return;
+				R.Request->WaitCompletion();
+				R.FileSize = R.Request->GetSizeResults();
+				delete R.Request;
+				R.Request = nullptr;
+			};
+
+		// 1) tamanhos, todos em voo; sem .uasset tenta .umap (mapas são poucos)
+		for (int32 Idx = 0; Idx < BasePaths.Num(); ++Idx)
+			RequestSize(Reads[Idx], BasePaths[Idx] + TEXT(".uasset"));
+		for (int32 Idx = 0; Idx < BasePaths.Num(); ++Idx)
+		{
+			WaitSize(Reads[Idx]);
+			if (Reads[Idx].FileSize <= 0)
+			{
+				RequestSize(Reads[Idx], BasePaths[Idx] + TEXT(".umap"));
+				WaitSize(Reads[Idx]);
+			}
+		}
+
+		// 2) começo de cada arquivo, todas as leituras em voo
+		for (FPendingRead& R : Reads)
+		{
+			if (R.FileSize <= 0) continue;
+			R.Header.SetNumUninitialized(int32(FMath::Min(R.FileSize, InitialHeaderRead)));
+			R.Request = R.Handle->ReadRequest(0, R.Header.Num(), AIOP_Normal, nullptr, R.Header.GetData());
+		}
+
+		// 3) decodifica na ordem; header maior que a primeira leitura busca o resto
+		TArray<FName> ScriptPackages;
+		for (int32 Idx = 0; Idx < Reads.Num(); ++Idx)
+		{
+			FPendingRead& R = Reads[Idx];
+			if (!R.Request || !FinishRead(R.Request))
+			{
+				R.Handle.Reset();
+				continue;
+			}
+
+			ScriptPackages.Reset();
+			int64 HeaderSize = 0;
+			bool bRead = ReadScriptImports(R.Header, ScriptPackages, HeaderSize);
+			if (!bRead && HeaderSize > R.Header.Num() && HeaderSize <= FMath::Min(R.FileSize, MaxHeaderSize))
+			{
+				const int32 Have = R.Header.Num();
+				R.Header.SetNumUninitialized(int32(HeaderSize));
+				R.Request = R.Handle->ReadRequest(Have, HeaderSize - Have, AIOP_Normal, nullptr, R.Header.GetData() + Have);
+				if (FinishRead(R.Request))
+				{
+					ScriptPackages.Reset();
+					bRead = ReadScriptImports(R.Header, ScriptPackages, HeaderSize);
+				}
+			}
+
+			R.Header.Empty();
+			R.Handle.Reset();
+			if (bRead)
+				Visit(Idx, ScriptPackages);
+		}
+	}
+}
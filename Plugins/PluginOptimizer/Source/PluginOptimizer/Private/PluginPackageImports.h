@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*
+ * Passada profunda (opcional): lê só o header dos .uasset/.umap (resumo,
+ * name map e tabela de imports) direto do disco, sem carregar o pacote, e
+ * devolve os "/Script/Module" importados. Pega componentes, structs e
+ * bibliotecas de funções que um Blueprint usa por dentro e que não aparecem
+ * nas tags do registry.
+ */
+namespace PluginScan
+{
+	// Imports "/Script/..." de um pacote; Header é o começo do arquivo. Se o
+	// header não coube, retorna false com OutHeaderSize > Header.Num(); false
+	// com OutHeaderSize <= Header.Num() = não é um pacote legível
+	bool ReadScriptImports(TConstArrayView<uint8> Header, TArray<FName>& OutScriptPackages, int64& OutHeaderSize);
+
+	// Lê o header de cada arquivo com as leituras assíncronas em voo ao mesmo
+	// tempo. BasePaths sem extensão (tenta .uasset e depois .umap).
+	// Visit(Index, ScriptPackages) para cada pacote legível, em ordem
+	void ReadPackageImports(TConstArrayView<FString> BasePaths,
+		TFunctionRef<void(int32, TConstArrayView<FName>)> Visit);
+}
@@ -0,0 +1,122 @@
+#include "PluginScanCache.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Serialization/Archive.h"
+
+namespace
+{
+	constexpr uint32 CacheMagic = 0x504F5343;     // "POSC"
+	constexpr uint32 CacheVersion = 2;
+
+	void SerializeHits(FArchive& Ar, TArray<int32>& Hits, const TArray<int32>* Remap)
+	{
+		Ar << Hits;
+		if (Remap)
+		{
+			for (int32& Idx : Hits)
+			{
+				if (!Remap->IsValidIndex(Idx))
+				{
+					Ar.SetError();
+					return;
+				}
+				Idx = (*Remap)[Idx];
+			}
+		}
+	}
+}
+
+FString FPluginScanCache::GetDefaultPath()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("PluginOptimizer"), TEXT("ScanCache.bin"));
+}
+
+bool FPluginScanCache::Load(const FString& Path, uint32 Signature, const TArray<FString>& PluginNames)
+{
+	Entries.Reset();
+
+	TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileReader(*Path));
+	if (!Ar) return false;
+
+	uint32 Magic = 0, Version = 0, FileSignature = 0;
+	*Ar << Magic << Version << FileSignature;
+	if (Magic != CacheMagic || Version != CacheVersion || FileSignature != Signature)
+		return false;
+
+	// índice gravado -> índice desta sessão
+	TArray<FString> FileNames;
+	*Ar << FileNames;
+
+	TArray<int32> Remap;
+	Remap.Reserve(FileNames.Num());
+	for (const FString& Name : FileNames)
+	{
+		const int32 Idx = PluginNames.IndexOfByKey(Name);
+		if (Idx == INDEX_NONE) return false;
+		Remap.Add(Idx);
+	}
+
+	int32 Num = 0;
+	*Ar << Num;
+	if (Ar->IsError() || Num < 0) return false;
+	Entries.Reserve(Num);
+
+	FString PackageName;
+	for (int32 i = 0; i < Num && !Ar->IsError(); ++i)
+	{
+		FPluginScanCacheEntry Entry;
+		*Ar << PackageName << Entry.Hash;
+		SerializeHits(*Ar, Entry.AssetHits, &Remap);
+		SerializeHits(*Ar, Entry.DependencyHits, &Remap);
+		SerializeHits(*Ar, Entry.ImportHits, &Remap);
+		Entries.Add(FName(*PackageName), MoveTemp(Entry));
+	}
+
+	if (Ar->IsError())
+	{
+		Entries.Reset();
+		return false;
+	}
+	return true;
+}
+
+bool FPluginScanCache::Save(const FString& Path, uint32 Signature, const TArray<FString>& PluginNames) const
+{
+	// grava num temporário e troca no fim: um scan cancelado não corrompe o cache.
+	// Nome único: um scan cancelado ainda salvando, o próximo e o commandlet
+	// podem gravar ao mesmo tempo
+	const FString TempPath = FPaths::CreateTempFilename(*FPaths::GetPath(Path), TEXT("ScanCache"), TEXT(".tmp"));
+	bool bWritten = false;
+	{
+		TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileWriter(*TempPath));
+		if (!Ar) return false;
+
+		uint32 Magic = CacheMagic, Version = CacheVersion, FileSignature = Signature;
+		*Ar << Magic << Version << FileSignature;
+
+		TArray<FString> Names = PluginNames;
+		*Ar << Names;
+
+		int32 Num = Entries.Num();
+		*Ar << Num;
+
+		FString PackageName;
+		for (const TPair<FName, FPluginScanCacheEntry>& Pair : Entries)
+		{
+			FPluginScanCacheEntry& Entry = const_cast<FPluginScanCacheEntry&>(Pair.Value);
+			PackageName = Pair.Key.ToString();
+			*Ar << PackageName << Entry.Hash;
+			SerializeHits(*Ar, Entry.AssetHits, nullptr);
+			SerializeHits(*Ar, Entry.DependencyHits, nullptr);
+			SerializeHits(*Ar, Entry.ImportHits, nullptr);
+		}
+
+		bWritten = Ar->Close();
+	}
+	if (bWritten && IFileManager::Get().Move(*Path, *TempPath, true, true))
+		return true;
+
+	IFileManager::Get().Delete(*TempPath, false, false, true);
+	return false;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IO/IoHash.h"
+
+/* Hits já resolvidos de um pacote de /Game, válidos enquanto o hash não mudar */
+struct FPluginScanCacheEntry
+{
+	FIoHash       Hash;
+	TArray<int32> AssetHits;        // passada 1 (classes / tags)
+	TArray<int32> DependencyHits;   // passada 2 (dependências do pacote)
+	TArray<int32> ImportHits;       // passada profunda (tabela de imports)
+};
+
+/*
+ * Cache em disco (Saved/PluginOptimizer/) dos hits por pacote. Os índices são
+ * gravados junto com a tabela de nomes dos plugins e remapeados no Load, já que
+ * a ordem de GetEnabledPlugins pode mudar entre sessões.
+ */
+class FPluginScanCache
+{
+public:
+	static FString GetDefaultPath();
+
+	// false se o arquivo não existe, é de outra versão ou de outro conjunto de plugins
+	bool Load(const FString& Path, uint32 Signature, const TArray<FString>& PluginNames);
+	bool Save(const FString& Path, uint32 Signature, const TArray<FString>& PluginNames) const;
+
+	// nullptr se o pacote não está no cache ou foi modificado desde então
+	const FPluginScanCacheEntry* Find(FName Package, const FIoHash& Hash) const
+	{
+		const FPluginScanCacheEntry* Entry = Entries.Find(Package);
+		return (Entry && Entry->Hash == Hash && !Hash.IsZero()) ? Entry : nullptr;
+	}
+
+	void Reserve(int32 Num) { Entries.Reserve(Num); }
+	void Add(FName Package, FPluginScanCacheEntry&& Entry) { Entries.Add(Package, MoveTemp(Entry)); }
+	int32 Num() const { return Entries.Num(); }
+
+private:
+	TMap<FName, FPluginScanCacheEntry> Entries;
+};
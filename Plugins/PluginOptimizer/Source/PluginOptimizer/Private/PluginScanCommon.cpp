@@ -0,0 +1,320 @@
+#include "PluginScanCommon.h"
+#include "PluginDependencyGraph.h"
+#include "PluginTargetAnalysis.h"
+#include "PluginScanSource.h"
+
+#include "Interfaces/IPluginManager.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "AssetRegistry/AssetData.h"
+#include "Modules/ModuleManager.h"
+#include "GenericPlatform/GenericPlatformFile.h"
+#include "Async/MappedFileHandle.h"
+#include "Misc/FileHelper.h"
+#include "String/Find.h"
+
+namespace PluginScan
+{
+	// Tags que apontam para classes nativas (valor é um export path)
+	static const FName ClassTags[] = { "NativeParentClass", "ParentClass", "GeneratedClass" };
+	static const FName InterfacesTag("ImplementedInterfaces");
+
+	bool FScanContext::CheckGoals(const TBitArray<>& Used) const
+	{
+		if (bGoalsMet) return true;
+		if (Goals.IsEmpty()) return false;
+
+		for (const TBitArray<>& Goal : Goals)
+		{
+			bool bHit = false;
+			for (TConstSetBitIterator<> It(Goal); It && !bHit; ++It)
+				bHit = Used[It.GetIndex()] || UsedSoFar[It.GetIndex()];
+			if (!bHit) return false;
+		}
+		bGoalsMet = true;
+		return true;
+	}
+
+	IAssetRegistry& GetAssetRegistry()
+	{
+		FAssetRegistryModule& ARM = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
+		return ARM.Get();
+	}
+
+	TArray<FScanPlugin> GatherEnabledPlugins()
+	{
+		check(IsInGameThread());
+
+		TArray<FScanPlugin> Out;
+		for (const TSharedRef<IPlugin>& P : IPluginManager::Get().GetEnabledPlugins())
+		{
+			FScanPlugin& SP = Out.AddDefaulted_GetRef();
+			SP.Name = P->GetName();
+			SP.BaseDir = P->GetBaseDir();
+
+			// 5.0-5.5: FName   |   5.6: FString
+			auto MountPath = P->GetMountedAssetPath();
+			SP.MountPath = FString(MountPath);		// ctor aceita FName ou FString
+
+			CopyDescriptor(P->GetDescriptor(), SP);
+		}
+		return Out;
+	}
+
+	void CopyDescriptor(const FPluginDescriptor& Descriptor, FScanPlugin& Out)
+	{
+		for (const FModuleDescriptor& M : Descriptor.Modules)
+		{
+			Out.Modules.Add(M.Name);
+			Out.ModuleTypes.Add(M.Type);
+			Out.ModulePhases.Add(M.LoadingPhase);
+
+			FModuleTargetFilter& Filter = Out.ModuleFilters.AddDefaulted_GetRef();
+			Filter.TargetAllowList = M.TargetAllowList;
+			Filter.TargetDenyList = M.TargetDenyList;
+			Filter.PlatformAllowList = M.PlatformAllowList;
+			Filter.PlatformDenyList = M.PlatformDenyList;
+			Filter.ConfigurationAllowList = M.TargetConfigurationAllowList;
+			Filter.ConfigurationDenyList = M.TargetConfigurationDenyList;
+			Filter.bHasExplicitPlatforms = M.bHasExplicitPlatforms;
+		}
+
+		for (const FPluginReferenceDescriptor& Dep : Descriptor.Plugins)
+		{
+			if (Dep.bEnabled && !Dep.bOptional)
+				Out.Dependencies.Add(Dep.Name);
+		}
+
+		Out.SupportedTargetPlatforms = Descriptor.SupportedTargetPlatforms;
+		Out.bHasExplicitPlatforms = Descriptor.bHasExplicitPlatforms;
+	}
+
+	void BuildResolver(const TArray<FScanPlugin>& Plugins, FPluginModuleResolver& OutResolver)
+	{
+		for (int32 Idx = 0; Idx < Plugins.Num(); ++Idx)
+		{
+			for (const FName M : Plugins[Idx].Modules)
+				OutResolver.AddModule(M, Idx);
+			OutResolver.AddMountPath(Plugins[Idx].MountPath, Idx);
+		}
+	}
+
+	void BuildResolver(const TArray<FScanPlugin>& Plugins, const FPluginBaseIndex* Base,
+		FPluginBaseLayer& OutLayer, FPluginModuleResolver& OutResolver)
+	{
+		OutLayer.Base = Base;
+		OutLayer.Covered.Init(false, Plugins.Num());
+		if (!Base)
+		{
+			BuildResolver(Plugins, OutResolver);
+			return;
+		}
+
+		TMap<FString, int32> LocalByName;
+		LocalByName.Reserve(Plugins.Num());
+		for (int32 Idx = 0; Idx < Plugins.Num(); ++Idx)
+			LocalByName.Add(Plugins[Idx].Name, Idx);
+
+		// plugin de projeto com o nome de um do engine o substitui: não é o da base
+		OutLayer.BaseToLocal.Init(INDEX_NONE, Base->Plugins.Num());
+		for (int32 BaseIdx = 0; BaseIdx < Base->Plugins.Num(); ++BaseIdx)
+		{
+			const FScanPlugin& BasePlugin = Base->Plugins[BaseIdx];
+			const int32* Local = LocalByName.Find(BasePlugin.Name);
+			if (Local && Plugins[*Local].BaseDir == BasePlugin.BaseDir)
+			{
+				OutLayer.BaseToLocal[BaseIdx] = *Local;
+				OutLayer.Covered[*Local] = true;
+			}
+		}
+
+		OutResolver.SetBase(&Base->Resolver, OutLayer.BaseToLocal);
+		for (int32 Idx = 0; Idx < Plugins.Num(); ++Idx)
+		{
+			if (OutLayer.Covered[Idx])
+				continue;
+			for (const FName M : Plugins[Idx].Modules)
+				OutResolver.AddModule(M, Idx);
+			OutResolver.AddMountPath(Plugins[Idx].MountPath, Idx);
+		}
+	}
+
+	void VisitMappedBytes(IPlatformFile& PF, const FString& Path, TFunctionRef<void(TArrayView64<const uint8>)> Visit)
+	{
+		TUniquePtr<IMappedFileHandle> Handle(PF.OpenMapped(*Path));
+		if (Handle && Handle->GetFileSize() > 0)
+		{
+			TUniquePtr<IMappedFileRegion> Region(Handle->MapRegion(0, Handle->GetFileSize()));
+			if (Region)
+			{
+				Visit(TArrayView64<const uint8>(Region->GetMappedPtr(), Region->GetMappedSize()));
+				return;
+			}
+		}
+
+		TArray64<uint8> Bytes;
+		if (FFileHelper::LoadFileToArray(Bytes, *Path, FILEREAD_Silent) && Bytes.Num())
+			Visit(Bytes);
+	}
+
+	void VisitMappedFile(IPlatformFile& PF, const FString& Path, TFunctionRef<void(FAnsiStringView)> Visit)
+	{
+		VisitMappedBytes(PF, Path, [&Visit](TArrayView64<const uint8> Bytes)
+			{
+				// texto de mais de 2 GB não é fonte nem .ini
+				if (Bytes.Num() <= MAX_int32)
+					Visit(FAnsiStringView(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), int32(Bytes.Num())));
+			});
+	}
+
+	void FinalizeResult(const TArray<FScanPlugin>& Plugins, FPluginScanResult& Out,
+		FPluginEvidenceIndex* Evidence, const FString& TargetPlatform)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(PluginScan_FinalizeResult);
+
+		const int32 N = Plugins.Num();
+
+		FPluginDependencyGraph Graph;
+		Graph.Build(Plugins);
+
+		TBitArray<> Used(false, N);
+		for (int32 Idx = 0; Idx < N; ++Idx)
+			Used[Idx] = Out.UsageReasons[Idx] != EPluginUsageReason::None;
+
+		// plugin usado segura tudo de que depende
+		const TBitArray<> Added = Graph.PropagateUsed(Used);
+		for (TConstSetBitIterator<> It(Added); It; ++It)
+		{
+			Out.UsageReasons[It.GetIndex()] |= EPluginUsageReason::Dependency;
+
+			// quem segura: dependentes usados por conta própria
+			if (!Evidence)
+				continue;
+			for (TConstSetBitIterator<> Dep(Graph.GetDependents(It.GetIndex())); Dep; ++Dep)
+			{
+				if (Used[Dep.GetIndex()] && !Added[Dep.GetIndex()] && Evidence->CountHit(It.GetIndex()))
+					Evidence->Add(It.GetIndex(), EPluginEvidenceKind::Dependency, FName(*Plugins[Dep.GetIndex()].Name));
+			}
+		}
+
+		Out.UsedPlugins.Reset();
+		Out.RemovableGroups.Reset();
+		Out.RemovableGroups.SetNum(N);
+		for (int32 Idx = 0; Idx < N; ++Idx)
+		{
+			if (Used[Idx])
+			{
+				Out.UsedPlugins.Add(Plugins[Idx].Name);
+				continue;
+			}
+
+			TArray<FString>& Group = Out.RemovableGroups[Idx];
+			for (TConstSetBitIterator<> It(Graph.GetRemovableGroup(Idx, Used)); It; ++It)
+			{
+				if (It.GetIndex() != Idx)
+					Group.Add(Plugins[It.GetIndex()].Name);
+			}
+			Group.Sort();
+		}
+
+		Out.UsedPlugins.Sort([](const FString& A, const FString& B) { return A < B; });
+		Out.Used = MoveTemp(Used);
+
+		BuildTargetReports(Plugins, Graph, TargetPlatform, Out);
+	}
+
+	void ClassifyAssetClass(const FAssetData& AD, const FPluginModuleResolver& Resolver,
+		FClassifyScratch& Scratch, TBitArray<>& OutUsed)
+	{
+		++Scratch.Counters.AssetsVisited;
+
+		// classe do asset (diferença 5.0 vs 5.1+): o pacote já é "/Script/Module"
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 1
+		const int32 ClassPlugin = Resolver.FindByClassPath(WriteToString<256>(AD.AssetClass).ToView());
+#else
+		const int32 ClassPlugin = Resolver.FindByScriptPackage(AD.AssetClassPath.GetPackageName());
+#endif
+		MarkUsed(ClassPlugin, OutUsed, Scratch.Evidence, EPluginEvidenceKind::AssetClass, AD.PackageName, AD.AssetName);
+	}
+
+	void ClassifyGameAsset(const FAssetData& AD, const FPluginModuleResolver& Resolver,
+		FClassifyScratch& Scratch, TBitArray<>& OutUsed)
+	{
+		ClassifyAssetClass(AD, Resolver, Scratch, OutUsed);
+
+		for (const FName Tag : ClassTags)
+		{
+			++Scratch.Counters.TagLookups;
+			const FAssetTagValueRef Value = AD.TagsAndValues.FindTag(Tag);
+			if (!Value.IsSet())
+				continue;
+
+			// armazenamento compacto guarda export paths como FNames
+			const FAssetRegistryExportPath ExportPath = Value.AsExportPath();
+			if (!ExportPath.Package.IsNone())
+			{
+				MarkUsed(Resolver.FindByScriptPackage(ExportPath.Package), OutUsed, Scratch.Evidence,
+					EPluginEvidenceKind::ClassTag, AD.PackageName, AD.AssetName, Tag);
+			}
+			else if (Value.TryGetValue(Scratch.TagText))
+			{
+				MarkUsed(Resolver.FindByClassPath(Scratch.TagText), OutUsed, Scratch.Evidence,
+					EPluginEvidenceKind::ClassTag, AD.PackageName, AD.AssetName, Tag);
+			}
+		}
+
+		// lista de structs em texto: varre cada "/Script/" sem criar substrings
+		++Scratch.Counters.TagLookups;
+		const FAssetTagValueRef Interfaces = AD.TagsAndValues.FindTag(InterfacesTag);
+		if (Interfaces.IsSet() && Interfaces.TryGetValue(Scratch.TagText))
+		{
+			Resolver.ForEachScriptReference(Scratch.TagText, [&](int32 PluginIdx)
+				{
+					MarkUsed(PluginIdx, OutUsed, Scratch.Evidence,
+						EPluginEvidenceKind::ClassTag, AD.PackageName, AD.AssetName, InterfacesTag);
+				});
+		}
+	}
+
+	void ClassifyPackageDependencies(const IPluginScanSource& Source, FName PackageName,
+		const FPluginModuleResolver& Resolver, FClassifyScratch& Scratch, TBitArray<>& OutUsed)
+	{
+		++Scratch.Counters.DependencyQueries;
+		Scratch.Deps.Reset();
+		Source.GetDependencies(PackageName, Scratch.Deps);
+
+		for (const FName Dep : Scratch.Deps)
+			MarkUsed(Resolver.FindByPackageName(Dep), OutUsed, Scratch.Evidence,
+				EPluginEvidenceKind::PackageDependency, PackageName, Dep);
+	}
+
+	TArray<FGamePackage> GroupByPackage(TConstArrayView<FAssetData> GameAssets, TArray<int32>& OutAssetOrder)
+	{
+		OutAssetOrder.SetNumUninitialized(GameAssets.Num());
+		for (int32 Idx = 0; Idx < GameAssets.Num(); ++Idx)
+			OutAssetOrder[Idx] = Idx;
+
+		OutAssetOrder.Sort([&GameAssets](int32 A, int32 B)
+			{
+				return GameAssets[A].PackageName.FastLess(GameAssets[B].PackageName);
+			});
+
+		TArray<FGamePackage> Packages;
+		for (int32 Pos = 0; Pos < OutAssetOrder.Num(); ++Pos)
+		{
+			const FName Name = GameAssets[OutAssetOrder[Pos]].PackageName;
+			if (Packages.IsEmpty() || Packages.Last().Name != Name)
+				Packages.Add({ Name, Pos, 0 });
+			++Packages.Last().NumAssets;
+		}
+		return Packages;
+	}
+
+	bool IsExternalActorPackage(FName PackageName)
+	{
+		TStringBuilder<256> Name;
+		Name << PackageName;
+		return UE::String::FindFirst(Name.ToView(), TEXTVIEW("/__ExternalActors__/")) != INDEX_NONE
+			|| UE::String::FindFirst(Name.ToView(), TEXTVIEW("/__ExternalObjects__/")) != INDEX_NONE;
+	}
+}
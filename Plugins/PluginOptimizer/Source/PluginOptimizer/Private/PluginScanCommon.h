@@ -0,0 +1,324 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PluginUsageScanner.h"
+#include "PluginModuleResolver.h"
+#include "Async/ParallelFor.h"
+#include "HAL/PlatformMisc.h"
+#include "Misc/ScopeLock.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+struct FAssetData;
+struct FPluginDescriptor;
+class IAssetRegistry;
+class IPlatformFile;
+class IPluginScanSource;
+
+/*
+ * Peças compartilhadas entre o scan completo (FPluginUsageScanner) e o
+ * rastreamento incremental (FPluginUsageTracker).
+ */
+namespace PluginScan
+{
+	// Listas de alvo/plataforma/configuração de um módulo no descritor (UBT)
+	struct FModuleTargetFilter
+	{
+		TArray<EBuildTargetType> TargetAllowList;
+		TArray<EBuildTargetType> TargetDenyList;
+		TArray<FString> PlatformAllowList;      // nomes UBT: Win64, Linux...
+		TArray<FString> PlatformDenyList;
+		TArray<EBuildConfiguration> ConfigurationAllowList;
+		TArray<EBuildConfiguration> ConfigurationDenyList;
+		bool bHasExplicitPlatforms = false;     // allow list vazia = nenhuma plataforma
+	};
+
+	// Snapshot de um plugin habilitado (tirado no game thread)
+	struct FScanPlugin
+	{
+		FString Name;
+		FString MountPath;
+		FString BaseDir;
+		TArray<FName> Modules;
+		TArray<EHostType::Type> ModuleTypes;        // paralelos a Modules
+		TArray<ELoadingPhase::Type> ModulePhases;
+		TArray<FModuleTargetFilter> ModuleFilters;
+		TArray<FString> Dependencies;       // plugins obrigatórios (descritor)
+
+		// SupportedTargetPlatforms do descritor; vazio = todas (sem bHasExplicitPlatforms)
+		TArray<FString> SupportedTargetPlatforms;
+		bool bHasExplicitPlatforms = false;
+	};
+
+	// Cancelamento + progresso de uma execucao do scan
+	struct FScanContext
+	{
+		const FPluginScanTask* Task = nullptr;		// nullptr = scan sincrono
+		TFunction<void(const FPluginScanProgress&)> OnProgress;
+
+		// Só tocado pela thread que conduz o scan (os chunks somam no fim)
+		FPluginScanCounters* Counters = nullptr;
+
+		// Idem; RunScan cria conforme Options.MaxEvidencePerPlugin (nullptr = não coleta).
+		// As passadas paralelas coletam por chunk e mesclam aqui no fim
+		FPluginEvidenceIndex* Evidence = nullptr;
+
+		// Plugins cujo uso basta confirmar; vazio = todos os de RunScan
+		TArray<FString> Targets;
+
+		// Parada antecipada (RunScan preenche): por alvo, ele + quem depende dele.
+		// Quando cada um tem um bit usado, as passadas restantes são puladas
+		TArray<TBitArray<>> Goals;
+
+		// Uso das passadas anteriores; só a thread que conduz o scan escreve
+		TBitArray<> UsedSoFar;
+
+		// Used (de um chunk ou da passada) + UsedSoFar cobrem todos os alvos?
+		// Pode ser chamado de qualquer worker; o primeiro que confirmar avisa os outros
+		bool CheckGoals(const TBitArray<>& Used) const;
+
+		bool AreGoalsMet() const { return bGoalsMet; }
+
+		void AddCounters(const FPluginScanCounters& Delta) const
+		{
+			if (Counters) *Counters += Delta;
+		}
+
+		bool IsCancelled() const { return Task && Task->IsCancelled(); }
+
+		// pode ser chamado de qualquer worker
+		void Report(EPluginScanPhase Phase, float Fraction) const
+		{
+			if (OnProgress)
+			{
+				FScopeLock Lock(&ProgressLock);
+				FPluginScanProgress P;
+				P.Phase = Phase;
+				P.Fraction = Fraction;
+				OnProgress(P);
+			}
+		}
+
+	private:
+		mutable FCriticalSection ProgressLock;
+		mutable std::atomic<bool> bGoalsMet{ false };
+	};
+
+	IAssetRegistry& GetAssetRegistry();
+
+	// IPluginManager nao e thread-safe: copia o que o scan precisa
+	TArray<FScanPlugin> GatherEnabledPlugins();
+
+	// Módulos (com tipo, fase e filtros), plataformas e dependências obrigatórias do descritor
+	void CopyDescriptor(const FPluginDescriptor& Descriptor, FScanPlugin& Out);
+
+	// módulo / raiz de conteúdo -> plugin
+	void BuildResolver(const TArray<FScanPlugin>& Plugins, FPluginModuleResolver& OutResolver);
+
+	// Resolver e índice de headers montados uma vez para um conjunto de plugins
+	// (no batch, todos os do engine) e compartilhados, só leitura, entre scans
+	struct FPluginBaseIndex
+	{
+		TArray<FScanPlugin> Plugins;
+		FPluginModuleResolver Resolver;
+		TMap<uint64, int32> Headers;        // caminho de include (hash) -> plugin da base; vazio sem bScanSource
+	};
+
+	// Como um scan enxerga a base: plugin da base com o mesmo nome e pasta de um
+	// plugin do scan vira o índice local; o resto fica de fora
+	struct FPluginBaseLayer
+	{
+		const FPluginBaseIndex* Base = nullptr;
+		TArray<int32> BaseToLocal;          // INDEX_NONE = fora deste scan
+		TBitArray<> Covered;                // por plugin do scan: já está na base
+	};
+
+	// Com Base, o resolver fica por cima do da base e só adiciona os plugins que
+	// ela não cobre. OutLayer precisa viver tanto quanto OutResolver
+	void BuildResolver(const TArray<FScanPlugin>& Plugins, const FPluginBaseIndex* Base,
+		FPluginBaseLayer& OutLayer, FPluginModuleResolver& OutResolver);
+
+	// Visit(Bytes) com o conteúdo bruto do arquivo, mapeado em memória (ou lido
+	// inteiro onde não há mapeamento); tamanho em 64 bits, para registries > 2 GB.
+	// Arquivo vazio não chama Visit.
+	void VisitMappedBytes(IPlatformFile& PF, const FString& Path, TFunctionRef<void(TArrayView64<const uint8>)> Visit);
+
+	// Idem como texto, para os scanners de código e config (arquivo > 2 GB é ignorado)
+	void VisitMappedFile(IPlatformFile& PF, const FString& Path, TFunctionRef<void(FAnsiStringView)> Visit);
+
+	// Todas as passadas sobre Source (sem a espera pelo registry); é o corpo de
+	// FPluginUsageScanner::Scan/ScanAsync e do benchmark. Com Base, o resolver e
+	// os headers dos plugins que ela cobre vêm prontos. False se cancelado.
+	bool RunScan(const TArray<FScanPlugin>& Plugins, const FPluginScanOptions& Options,
+		const IPluginScanSource& Source, FScanContext& Ctx, FPluginScanResult& Out,
+		const FPluginBaseIndex* Base = nullptr);
+
+	// RunScan sobre um AssetRegistry.bin serializado (sem módulos carregados);
+	// não toca o game thread. False se o arquivo não pôde ser lido.
+	bool RunRegistryFileScan(const TArray<FScanPlugin>& Plugins, const FString& RegistryPath,
+		const FPluginScanOptions& Options, FPluginScanResult& Out, const FPluginBaseIndex* Base = nullptr);
+
+	// Com UsageReasons já preenchido: propaga o uso pelas dependências entre
+	// plugins e preenche UsedPlugins, RemovableGroups e TargetReports. Com Evidence, registra
+	// quem segurou cada plugin marcado só por dependência.
+	// TargetPlatform vai para os relatórios por alvo (vazio = a do editor).
+	void FinalizeResult(const TArray<FScanPlugin>& Plugins, FPluginScanResult& Out,
+		FPluginEvidenceIndex* Evidence = nullptr, const FString& TargetPlatform = FString());
+
+	// Por worker: buffers reaproveitados entre pacotes
+	struct FClassifyScratch
+	{
+		FString TagText;            // tags que não vêm como export path
+		TArray<FName> Deps;
+		FPluginScanCounters Counters;
+		FPluginEvidenceIndex* Evidence = nullptr;   // do chunk; nullptr = não coleta
+	};
+
+	inline void MarkUsed(int32 PluginIdx, TBitArray<>& OutUsed)
+	{
+		if (PluginIdx != INDEX_NONE)
+			OutUsed[PluginIdx] = true;
+	}
+
+	// MarkUsed + evidência; AddEvidence(Index, PluginIdx) só roda se o plugin
+	// ainda tem vaga, então nomes caros de montar ficam dentro dele
+	template <typename FuncType>
+	void MarkUsedWith(int32 PluginIdx, TBitArray<>& OutUsed, FPluginEvidenceIndex* Evidence, const FuncType& AddEvidence)
+	{
+		if (PluginIdx == INDEX_NONE)
+			return;
+		OutUsed[PluginIdx] = true;
+		if (Evidence && Evidence->CountHit(PluginIdx))
+			AddEvidence(*Evidence, PluginIdx);
+	}
+
+	inline void MarkUsed(int32 PluginIdx, TBitArray<>& OutUsed, FPluginEvidenceIndex* Evidence,
+		EPluginEvidenceKind Kind, FName Subject, FName Detail = NAME_None, FName Tag = NAME_None)
+	{
+		MarkUsedWith(PluginIdx, OutUsed, Evidence, [&](FPluginEvidenceIndex& Index, int32 Idx)
+			{
+				Index.Add(Idx, Kind, Subject, Detail, Tag);
+			});
+	}
+
+	// Trecho de texto (linha, include...) como nome de evidência
+	template <typename CharType>
+	FName MakeEvidenceName(TStringView<CharType> Text)
+	{
+		return FName(FMath::Min(Text.Len(), NAME_SIZE - 1), Text.GetData());
+	}
+
+	// Só a classe do asset (caminho leve dos actors externos)
+	void ClassifyAssetClass(const FAssetData& AD, const FPluginModuleResolver& Resolver,
+		FClassifyScratch& Scratch, TBitArray<>& OutUsed);
+
+	// Classe do asset + tags que apontam para classes nativas
+	void ClassifyGameAsset(const FAssetData& AD, const FPluginModuleResolver& Resolver,
+		FClassifyScratch& Scratch, TBitArray<>& OutUsed);
+
+	// Dependências (hard + soft) de um pacote, classificadas pela raiz
+	void ClassifyPackageDependencies(const IPluginScanSource& Source, FName PackageName,
+		const FPluginModuleResolver& Resolver, FClassifyScratch& Scratch, TBitArray<>& OutUsed);
+
+	// Pacote de /Game: seus assets ficam contíguos em AssetOrder
+	struct FGamePackage
+	{
+		FName Name;
+		int32 FirstAsset = 0;
+		int32 NumAssets = 0;
+	};
+
+	TArray<FGamePackage> GroupByPackage(TConstArrayView<FAssetData> GameAssets, TArray<int32>& OutAssetOrder);
+
+	// Pacote de One File Per Actor (".../__ExternalActors__/..." ou "__ExternalObjects__")
+	bool IsExternalActorPackage(FName PackageName);
+
+	// Itens por chunk nas passadas paralelas (abaixo disso não compensa)
+	constexpr int32 MinItemsPerChunk = 2048;
+
+	// Estado de um chunk paralelo: used-set local + buffers reaproveitados
+	struct FChunkState
+	{
+		TBitArray<> Used;
+		TBitArray<> PackageUsed;        // hits de um único pacote
+		FClassifyScratch Scratch;
+		TOptional<FPluginEvidenceIndex> Evidence;
+	};
+
+	// Divide [0, Num) em chunks contíguos, cada um com seu próprio used-set;
+	// o merge (OR) no fim dá exatamente o mesmo resultado da versão serial.
+	// Chunks param cedo quando Ctx.Goals é atingido (o merge continua valendo).
+	// Body(Index, ChunkState). Retorna false se foi cancelado. bReportFraction
+	// = false quando [0, Num) é só um lote de um total desconhecido: a fração
+	// recomeçaria a cada chamada, então quem chama reporta a fase como indeterminada
+	template <typename BodyType>
+	bool ParallelClassify(int32 Num, int32 NumPlugins, EPluginScanPhase Phase,
+		const FScanContext& Ctx, TBitArray<>& InOutUsed, const BodyType& Body,
+		int32 MinChunkItems = MinItemsPerChunk, bool bReportFraction = true)
+	{
+		const int32 MaxChunks = FPlatformMisc::NumberOfCoresIncludingHyperthreads() * 4;
+		const int32 NumChunks = FMath::Clamp(FMath::DivideAndRoundUp(Num, MinChunkItems), 1, MaxChunks);
+		const int32 ChunkSize = FMath::DivideAndRoundUp(Num, NumChunks);
+
+		TArray<FChunkState> Chunks;
+		Chunks.SetNum(NumChunks);
+		std::atomic<int32> ItemsDone{ 0 };
+
+		ParallelFor(NumChunks, [&](int32 ChunkIdx)
+			{
+				TRACE_CPUPROFILER_EVENT_SCOPE(PluginScan_Chunk);
+
+				FChunkState& State = Chunks[ChunkIdx];
+				State.Used.Init(false, NumPlugins);
+				if (Ctx.Evidence)
+				{
+					State.Evidence.Emplace(NumPlugins, Ctx.Evidence->GetMaxPerPlugin());
+					State.Scratch.Evidence = State.Evidence.GetPtrOrNull();
+				}
+
+				const int32 Begin = ChunkIdx * ChunkSize;
+				const int32 End = FMath::Min(Begin + ChunkSize, Num);
+
+				for (int32 Idx = Begin; Idx < End; ++Idx)
+				{
+					if (((Idx - Begin) & 1023) == 1023)
+					{
+						if (Ctx.IsCancelled() || Ctx.CheckGoals(State.Used)) return;
+						if (bReportFraction)
+							Ctx.Report(Phase, float(ItemsDone += 1024) / Num);
+					}
+
+					Body(Idx, State);
+				}
+			});
+
+		if (Ctx.IsCancelled()) return false;
+
+		for (const FChunkState& State : Chunks)
+		{
+			InOutUsed.CombineWithBitwiseOR(State.Used, EBitwiseOperatorFlags::MaintainSize);
+			Ctx.AddCounters(State.Scratch.Counters);
+			if (Ctx.Evidence && State.Evidence)
+				Ctx.Evidence->Merge(*State.Evidence);
+		}
+		return true;
+	}
+
+	// Roda Classify(Bits) para um pacote. Com OutHits, Classify escreve num bitset
+	// temporário cujos bits viram OutHits e depois entram no used-set do chunk.
+	template <typename FuncType>
+	void ClassifyPackage(FChunkState& State, TArray<int32>* OutHits, const FuncType& Classify)
+	{
+		if (!OutHits)
+		{
+			Classify(State.Used);
+			return;
+		}
+
+		State.PackageUsed.Init(false, State.Used.Num());
+		Classify(State.PackageUsed);
+
+		for (TConstSetBitIterator<> It(State.PackageUsed); It; ++It)
+			OutHits->Add(It.GetIndex());
+		State.Used.CombineWithBitwiseOR(State.PackageUsed, EBitwiseOperatorFlags::MaintainSize);
+	}
+}
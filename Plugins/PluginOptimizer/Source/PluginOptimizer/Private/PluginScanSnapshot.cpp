@@ -0,0 +1,149 @@
+#include "PluginScanSnapshot.h"
+#include "PluginUsageScanner.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "Serialization/Archive.h"
+
+namespace
+{
+	constexpr uint32 SnapshotMagic = 0x504F534E;  // "POSN"
+	constexpr uint32 SnapshotVersion = 1;
+
+	TArray<FString> ToNames(const TBitArray<>& Bits, const TArray<FString>& Plugins)
+	{
+		TArray<FString> Names;
+		for (TConstSetBitIterator<> It(Bits); It; ++It)
+			Names.Add(Plugins[It.GetIndex()]);
+		return Names;
+	}
+
+	// união de duas tabelas ordenadas (merge linear)
+	TArray<FString> MergeSorted(const TArray<FString>& A, const TArray<FString>& B)
+	{
+		TArray<FString> Out;
+		Out.Reserve(FMath::Max(A.Num(), B.Num()));
+		int32 i = 0, j = 0;
+		while (i < A.Num() || j < B.Num())
+		{
+			if (j == B.Num() || (i < A.Num() && A[i] < B[j])) Out.Add(A[i++]);
+			else if (i == A.Num() || B[j] < A[i])             Out.Add(B[j++]);
+			else { Out.Add(A[i++]); ++j; }
+		}
+		return Out;
+	}
+}
+
+const TCHAR* FPluginScanSnapshot::LatestLabel = TEXT("Latest");
+
+FPluginScanSnapshot FPluginScanSnapshot::FromResult(const FPluginScanResult& Result, const FString& Label)
+{
+	FPluginScanSnapshot Snap;
+	Snap.Label = Label;
+	Snap.Timestamp = FDateTime::UtcNow();
+
+	// índice do resultado -> posição na tabela ordenada
+	TArray<int32> Order;
+	for (int32 Idx = 0; Idx < Result.EnabledPlugins.Num(); ++Idx) Order.Add(Idx);
+	Order.Sort([&Result](int32 A, int32 B) { return Result.EnabledPlugins[A] < Result.EnabledPlugins[B]; });
+
+	const int32 N = Order.Num();
+	Snap.Enabled.Init(true, N);
+	Snap.Used.Init(false, N);
+	for (int32 Pos = 0; Pos < N; ++Pos)
+	{
+		Snap.Plugins.Add(Result.EnabledPlugins[Order[Pos]]);
+		Snap.Used[Pos] = Result.Used[Order[Pos]];
+	}
+	Snap.Candidates = TBitArray<>::BitwiseXOR(Snap.Enabled, Snap.Used, EBitwiseOperatorFlags::MaxSize);
+	return Snap;
+}
+
+FString FPluginScanSnapshot::GetSnapshotPath(const FString& Label)
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("PluginOptimizer"), TEXT("Snapshots"),
+		FPaths::MakeValidFileName(Label) + TEXT(".snap"));
+}
+
+bool FPluginScanSnapshot::Load(const FString& Path)
+{
+	TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileReader(*Path));
+	if (!Ar) return false;
+
+	uint32 Magic = 0, Version = 0;
+	*Ar << Magic << Version;
+	if (Magic != SnapshotMagic || Version != SnapshotVersion)
+		return false;
+
+	*Ar << Label << Timestamp << Plugins << Enabled << Used;
+	if (Ar->IsError() || Enabled.Num() != Plugins.Num() || Used.Num() != Plugins.Num())
+		return false;
+
+	Candidates = TBitArray<>::BitwiseXOR(Enabled, Used, EBitwiseOperatorFlags::MaxSize);
+	return true;
+}
+
+bool FPluginScanSnapshot::Save(const FString& Path) const
+{
+	TUniquePtr<FArchive> Ar(IFileManager::Get().CreateFileWriter(*Path));
+	if (!Ar) return false;
+
+	FPluginScanSnapshot& Self = const_cast<FPluginScanSnapshot&>(*this);
+	uint32 Magic = SnapshotMagic, Version = SnapshotVersion;
+	*Ar << Magic << Version << Self.Label << Self.Timestamp << Self.Plugins << Self.Enabled << Self.Used;
+	return Ar->Close();
+}
+
+FPluginScanSnapshot FPluginScanSnapshot::Remap(const TArray<FString>& InPlugins) const
+{
+	FPluginScanSnapshot Out;
+	Out.Label = Label;
+	Out.Timestamp = Timestamp;
+	Out.Plugins = InPlugins;
+	Out.Enabled.Init(false, InPlugins.Num());
+	Out.Used.Init(false, InPlugins.Num());
+
+	// as duas tabelas são ordenadas: um único passo
+	for (int32 i = 0, j = 0; i < Plugins.Num() && j < InPlugins.Num(); )
+	{
+		if (Plugins[i] < InPlugins[j])      ++i;
+		else if (InPlugins[j] < Plugins[i]) ++j;
+		else
+		{
+			Out.Enabled[j] = Enabled[i];
+			Out.Used[j] = Used[i];
+			++i; ++j;
+		}
+	}
+	Out.Candidates = TBitArray<>::BitwiseXOR(Out.Enabled, Out.Used, EBitwiseOperatorFlags::MaxSize);
+	return Out;
+}
+
+FPluginScanDiff FPluginScanDiff::Compute(const FPluginScanSnapshot& InBefore, const FPluginScanSnapshot& InAfter)
+{
+	// mesma tabela dos dois lados; daqui em diante só operações por palavra
+	const bool bSameTable = InBefore.GetPlugins() == InAfter.GetPlugins();
+	const TArray<FString> Plugins = bSameTable ? InAfter.GetPlugins() : MergeSorted(InBefore.GetPlugins(), InAfter.GetPlugins());
+	const FPluginScanSnapshot Before = bSameTable ? InBefore : InBefore.Remap(Plugins);
+	const FPluginScanSnapshot After = bSameTable ? InAfter : InAfter.Remap(Plugins);
+
+	constexpr EBitwiseOperatorFlags Flags = EBitwiseOperatorFlags::MaxSize;
+	const TBitArray<> EnabledChanged = TBitArray<>::BitwiseXOR(Before.GetEnabled(), After.GetEnabled(), Flags);
+
+	FPluginScanDiff Diff;
+	Diff.NewlyUsed = ToNames(TBitArray<>::BitwiseAND(Before.GetCandidates(), After.GetUsed(), Flags), Plugins);
+	Diff.NewlyUnused = ToNames(TBitArray<>::BitwiseAND(Before.GetUsed(), After.GetCandidates(), Flags), Plugins);
+	Diff.Added = ToNames(TBitArray<>::BitwiseAND(EnabledChanged, After.GetEnabled(), Flags), Plugins);
+	Diff.Removed = ToNames(TBitArray<>::BitwiseAND(EnabledChanged, Before.GetEnabled(), Flags), Plugins);
+	return Diff;
+}
+
+FString FPluginScanDiff::ToString() const
+{
+	TStringBuilder<1024> Out;
+	for (const FString& N : NewlyUsed)   Out.Appendf(TEXT("+used    %s\n"), *N);
+	for (const FString& N : NewlyUnused) Out.Appendf(TEXT("-used    %s\n"), *N);
+	for (const FString& N : Added)       Out.Appendf(TEXT("+enabled %s\n"), *N);
+	for (const FString& N : Removed)     Out.Appendf(TEXT("-enabled %s\n"), *N);
+	return FString(Out.ToView());
+}
@@ -0,0 +1,207 @@
+#include "PluginScanSource.h"
+
+#include "AssetRegistry/IAssetRegistry.h"
+#include "AssetRegistry/AssetData.h"
+#include "PluginScanCommon.h"
+#include "HAL/PlatformFileManager.h"
+#include "Serialization/LargeMemoryReader.h"
+
+void IPluginScanSource::VisitInBatches(TConstArrayView<FAssetData> Assets, int32 BatchSize, FAssetBatchVisitor Visit)
+{
+	BatchSize = FMath::Max(BatchSize, 1);
+	for (int32 Begin = 0; Begin < Assets.Num(); )
+	{
+		// estende o lote até a troca de pacote
+		int32 End = FMath::Min(Begin + BatchSize, Assets.Num());
+		while (End < Assets.Num() && Assets[End].PackageName == Assets[End - 1].PackageName)
+			++End;
+
+		if (!Visit(Assets.Slice(Begin, End - Begin)))
+			return;
+		Begin = End;
+	}
+}
+
+bool FAssetRegistryScanSource::IsLoading() const
+{
+	return Registry.IsLoadingAssets();
+}
+
+void FAssetRegistryScanSource::EnumerateAssetsByPath(FName Path, int32 BatchSize, FAssetBatchVisitor Visit) const
+{
+	// mount paths vêm com '/' no fim ("/Plugin/"); a árvore de pastas não
+	TStringBuilder<256> PathStr;
+	PathStr << Path;
+	if (PathStr.Len() > 1 && PathStr.ToView().EndsWith(TEXT('/')))
+		PathStr.RemoveSuffix(1);
+	const FName Root(PathStr.ToView());
+
+	// pasta por pasta (não recursivo): um pacote fica inteiro numa pasta, e só
+	// o lote corrente + os nomes das pastas ficam em memória
+	TArray<FName> Folders;
+	Folders.Add(Root);
+	Registry.GetSubPaths(Root, Folders, true);
+
+	TArray<FAssetData> Batch;
+	for (const FName Folder : Folders)
+	{
+		// só assets em disco: os em memória exigem o game thread
+		Registry.GetAssetsByPath(Folder, Batch, false, true);
+		if (Batch.Num() >= BatchSize)
+		{
+			if (!Visit(Batch))
+				return;
+			Batch.Reset();
+		}
+	}
+	if (!Batch.IsEmpty())
+		Visit(Batch);
+}
+
+void FAssetRegistryScanSource::GetDependencies(FName PackageName, TArray<FName>& OutDependencies) const
+{
+	Registry.GetDependencies(
+		PackageName,
+		OutDependencies,
+		UE::AssetRegistry::EDependencyCategory::Package,
+		UE::AssetRegistry::EDependencyQuery::Hard | UE::AssetRegistry::EDependencyQuery::Soft);
+}
+
+void FAssetRegistryScanSource::GetReferencers(FName PackageName, TArray<FName>& OutReferencers) const
+{
+	Registry.GetReferencers(
+		PackageName,
+		OutReferencers,
+		UE::AssetRegistry::EDependencyCategory::Package,
+		UE::AssetRegistry::EDependencyQuery::Hard | UE::AssetRegistry::EDependencyQuery::Soft);
+}
+
+FIoHash FAssetRegistryScanSource::GetPackageHash(FName PackageName) const
+{
+	const TOptional<FAssetPackageData> Data = Registry.GetAssetPackageDataCopy(PackageName);
+	if (!Data.IsSet()) return FIoHash::Zero;
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 1
+	return FIoHash::HashBuffer(&Data->PackageGuid, sizeof(FGuid));
+#else
+	return Data->GetPackageSavedHash();
+#endif
+}
+
+namespace
+{
+	// "/Game/A/B" -> "/Game"
+	FStringView GetRootPath(FStringView Path)
+	{
+		int32 Slash = INDEX_NONE;
+		if (Path.Len() > 1 && Path.RightChop(1).FindChar(TEXT('/'), Slash))
+			return Path.Left(Slash + 1);
+		return Path;
+	}
+
+	const UE::AssetRegistry::FDependencyQuery PackageQuery(
+		UE::AssetRegistry::EDependencyQuery::Hard | UE::AssetRegistry::EDependencyQuery::Soft);
+}
+
+bool FRegistryFileScanSource::Load(const FString& Path)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(PluginScan_LoadRegistryFile);
+
+	FAssetRegistryLoadOptions Options;
+	Options.bLoadDependencies = true;
+	Options.bLoadPackageData = true;
+	Options.ParallelWorkers = FPlatformMisc::NumberOfCoresIncludingHyperthreads();
+
+	bool bLoaded = false;
+	PluginScan::VisitMappedBytes(FPlatformFileManager::Get().GetPlatformFile(), Path, [&](TArrayView64<const uint8> Bytes)
+		{
+			FLargeMemoryReader Reader(Bytes.GetData(), Bytes.Num());
+			bLoaded = State.Load(Reader, Options) && !Reader.IsError();
+		});
+	if (!bLoaded)
+		return false;
+
+	// o estado é imutável daqui em diante: ponteiros para os FAssetData são estáveis
+	auto Index = [this](const FAssetData& AD)
+		{
+			const FName Root(GetRootPath(WriteToString<256>(AD.PackageName).ToView()));
+			AssetsByRoot.FindOrAdd(Root).Add(&AD);
+			++NumAssets;
+			return true;
+		};
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 4
+	State.EnumerateAllAssets(TSet<FName>(), Index);
+#else
+	State.EnumerateAllAssets(Index, UE::AssetRegistry::EEnumerateAssetsFlags::None);
+#endif
+
+	// assets do mesmo pacote contíguos: a enumeração fecha lotes na troca de pacote
+	for (TPair<FName, TArray<const FAssetData*>>& Pair : AssetsByRoot)
+	{
+		Pair.Value.Sort([](const FAssetData& A, const FAssetData& B)
+			{
+				return A.PackageName.FastLess(B.PackageName);
+			});
+	}
+	return true;
+}
+
+void FRegistryFileScanSource::EnumerateAssetsByPath(FName Path, int32 BatchSize, FAssetBatchVisitor Visit) const
+{
+	// mount paths vêm com '/' no fim ("/Plugin/")
+	TStringBuilder<256> PathStr;
+	PathStr << Path;
+	FStringView Prefix = PathStr.ToView();
+	if (Prefix.Len() > 1 && Prefix.EndsWith(TEXT('/')))
+		Prefix.LeftChopInline(1);
+
+	const TArray<const FAssetData*>* Assets = AssetsByRoot.Find(FName(GetRootPath(Prefix)));
+	if (!Assets)
+		return;
+
+	// raiz pedida inteira: sem filtro por prefixo
+	const bool bWholeRoot = GetRootPath(Prefix).Len() == Prefix.Len();
+	TArray<FAssetData> Batch;
+	for (const FAssetData* AD : *Assets)
+	{
+		if (!bWholeRoot && !WriteToString<256>(AD->PackageName).ToView().StartsWith(Prefix))
+			continue;
+
+		if (Batch.Num() >= BatchSize && Batch.Last().PackageName != AD->PackageName)
+		{
+			if (!Visit(Batch))
+				return;
+			Batch.Reset();
+		}
+		Batch.Add(*AD);
+	}
+	if (!Batch.IsEmpty())
+		Visit(Batch);
+}
+
+void FRegistryFileScanSource::GetDependencies(FName PackageName, TArray<FName>& OutDependencies) const
+{
+	TArray<FAssetIdentifier> Ids;
+	State.GetDependencies(FAssetIdentifier(PackageName), Ids, UE::AssetRegistry::EDependencyCategory::Package, PackageQuery);
+	for (const FAssetIdentifier& Id : Ids)
+		OutDependencies.Add(Id.PackageName);
+}
+
+void FRegistryFileScanSource::GetReferencers(FName PackageName, TArray<FName>& OutReferencers) const
+{
+	TArray<FAssetIdentifier> Ids;
+	State.GetReferencers(FAssetIdentifier(PackageName), Ids, UE::AssetRegistry::EDependencyCategory::Package, PackageQuery);
+	for (const FAssetIdentifier& Id : Ids)
+		OutReferencers.Add(Id.PackageName);
+}
+
+FIoHash FRegistryFileScanSource::GetPackageHash(FName PackageName) const
+{
+	// registries cooked costumam vir sem package data: zero desliga o cache
+	const FAssetPackageData* Data = State.GetAssetPackageData(PackageName);
+	if (!Data) return FIoHash::Zero;
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 1
+	return FIoHash::HashBuffer(&Data->PackageGuid, sizeof(FGuid));
+#else
+	return Data->GetPackageSavedHash();
+#endif
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IO/IoHash.h"
+#include "AssetRegistry/AssetRegistryState.h"
+
+struct FAssetData;
+class IAssetRegistry;
+
+// Recebe um lote de assets; false interrompe a enumeração
+using FAssetBatchVisitor = TFunctionRef<bool(TConstArrayView<FAssetData>)>;
+
+/*
+ * De onde o scan lê assets e dependências. O scan do editor usa o
+ * AssetRegistry; o benchmark usa um registry sintético
+ * (FSyntheticScanSource). As consultas podem vir de vários workers ao mesmo
+ * tempo, então implementações precisam ser thread-safe para leitura.
+ */
+class IPluginScanSource
+{
+public:
+	virtual ~IPluginScanSource() = default;
+
+	// true enquanto a coleta inicial ainda está rodando
+	virtual bool IsLoading() const = 0;
+
+	// Assets em disco sob Path, recursivo ("/Game" ou a raiz de um plugin), em
+	// lotes de ~BatchSize: só um lote fica em memória por vez e um pacote nunca
+	// é dividido entre dois lotes
+	virtual void EnumerateAssetsByPath(FName Path, int32 BatchSize, FAssetBatchVisitor Visit) const = 0;
+
+	// Dependências e referencers de pacote (hard + soft)
+	virtual void GetDependencies(FName PackageName, TArray<FName>& OutDependencies) const = 0;
+	virtual void GetReferencers(FName PackageName, TArray<FName>& OutReferencers) const = 0;
+
+	// Hash do pacote salvo; zero = desconhecido (o cache não é usado)
+	virtual FIoHash GetPackageHash(FName PackageName) const = 0;
+
+protected:
+	// Para fontes que já têm os assets em memória, agrupados por pacote
+	static void VisitInBatches(TConstArrayView<FAssetData> Assets, int32 BatchSize, FAssetBatchVisitor Visit);
+};
+
+class FAssetRegistryScanSource final : public IPluginScanSource
+{
+public:
+	explicit FAssetRegistryScanSource(IAssetRegistry& InRegistry) : Registry(InRegistry) {}
+
+	virtual bool IsLoading() const override;
+	virtual void EnumerateAssetsByPath(FName Path, int32 BatchSize, FAssetBatchVisitor Visit) const override;
+	virtual void GetDependencies(FName PackageName, TArray<FName>& OutDependencies) const override;
+	virtual void GetReferencers(FName PackageName, TArray<FName>& OutReferencers) const override;
+	virtual FIoHash GetPackageHash(FName PackageName) const override;
+
+private:
+	IAssetRegistry& Registry;
+};
+
+/*
+ * AssetRegistry.bin serializado (cooked ou de desenvolvimento), para o scan
+ * offline: o arquivo é mapeado em memória e desserializado direto das páginas
+ * mapeadas, sem editor nem registry vivo. Assets ficam indexados pela raiz
+ * ("/Game", "/Plugin") e ordenados por pacote, para a enumeração não varrer
+ * o estado inteiro e poder fechar lotes na troca de pacote.
+ */
+class FRegistryFileScanSource final : public IPluginScanSource
+{
+public:
+	// false se o arquivo não existe ou não é um AssetRegistry.bin legível
+	bool Load(const FString& Path);
+
+	int32 GetNumAssets() const { return NumAssets; }
+
+	virtual bool IsLoading() const override { return false; }
+	virtual void EnumerateAssetsByPath(FName Path, int32 BatchSize, FAssetBatchVisitor Visit) const override;
+	virtual void GetDependencies(FName PackageName, TArray<FName>& OutDependencies) const override;
+	virtual void GetReferencers(FName PackageName, TArray<FName>& OutReferencers) const override;
+	virtual FIoHash GetPackageHash(FName PackageName) const override;
+
+private:
+	FAssetRegistryState State;
+	TMap<FName, TArray<const FAssetData*>> AssetsByRoot;
+	int32 NumAssets = 0;
+};
@@ -0,0 +1,368 @@
+#include "PluginSourceScanner.h"
+
+#include "HAL/PlatformFileManager.h"
+#include "Misc/Paths.h"
+
+namespace PluginScan
+{
+	namespace
+	{
+		// FNV-1a sem diferenciar maiúsculas e com '\' == '/': serve tanto para
+		// os caminhos do disco (TCHAR) quanto para os #include mapeados (ANSI)
+		template <typename CharType>
+		uint64 HashIncludePath(TStringView<CharType> Path)
+		{
+			uint64 Hash = 0xcbf29ce484222325ull;
+			for (CharType C : Path)
+			{
+				if (C == '\\') C = '/';
+				else if (C >= 'A' && C <= 'Z') C += 'a' - 'A';
+				Hash = (Hash ^ uint64(C)) * 0x100000001b3ull;
+			}
+			return Hash;
+		}
+
+		bool IsHeader(FStringView Path)
+		{
+			return Path.EndsWith(TEXTVIEW(".h"), ESearchCase::IgnoreCase)
+				|| Path.EndsWith(TEXTVIEW(".hpp"), ESearchCase::IgnoreCase)
+				|| Path.EndsWith(TEXTVIEW(".inl"), ESearchCase::IgnoreCase);
+		}
+
+		bool IsBuildCs(FStringView Path)
+		{
+			return Path.EndsWith(TEXTVIEW(".Build.cs"), ESearchCase::IgnoreCase);
+		}
+
+		bool IsSourceFile(FStringView Path)
+		{
+			return IsBuildCs(Path) || IsHeader(Path) || Path.EndsWith(TEXTVIEW(".cpp"), ESearchCase::IgnoreCase);
+		}
+
+		// Headers do próprio projeto: cada sufixo do caminho ("Mod/Public/A/B.h",
+		// "Public/A/B.h", "A/B.h", "B.h") e o caminho completo, para os relativos
+		TSet<uint64> BuildLocalHeaderIndex(const TArray<FString>& Files)
+		{
+			TRACE_CPUPROFILER_EVENT_SCOPE(PluginScan_BuildLocalHeaderIndex);
+
+			TSet<uint64> Index;
+			for (const FString& File : Files)
+			{
+				if (!IsHeader(File))
+					continue;
+
+				const FString Full = FPaths::ConvertRelativePathToFull(File);
+				Index.Add(HashIncludePath(FStringView(Full)));
+				for (int32 Pos = 0; Pos < Full.Len(); ++Pos)
+				{
+					if (Full[Pos] == '/' || Full[Pos] == '\\')
+						Index.Add(HashIncludePath(FStringView(Full).RightChop(Pos + 1)));
+				}
+			}
+			return Index;
+		}
+
+		// O include acha um header do projeto? Relativo ("./", "../") parte da
+		// pasta de quem inclui; o resto casa com algum sufixo indexado
+		bool IsLocalInclude(FAnsiStringView Include, const TSet<uint64>& LocalHeaders, FStringView IncludingDir)
+		{
+			if (LocalHeaders.IsEmpty())
+				return false;
+
+			if (Include.StartsWith(".") && !IncludingDir.IsEmpty())
+			{
+				FString Path = FString(IncludingDir) / FString(Include);
+				return FPaths::CollapseRelativeDirectories(Path) && LocalHeaders.Contains(HashIncludePath(FStringView(Path)));
+			}
+			return LocalHeaders.Contains(HashIncludePath(Include));
+		}
+
+		int32 FindModule(const FPluginModuleResolver& Resolver, FAnsiStringView Name)
+		{
+			if (Name.IsEmpty() || Name.Len() >= NAME_SIZE)
+				return INDEX_NONE;
+
+			// nome que não está na tabela de FNames não é módulo de nenhum plugin
+			const FName ModuleName(Name.Len(), Name.GetData(), FNAME_Find);
+			return ModuleName.IsNone() ? INDEX_NONE : Resolver.FindByModuleName(ModuleName);
+		}
+
+		// Copia Text com os comentários // e /* */ trocados por espaços (quebras de
+		// linha ficam, literais de string e char são respeitados)
+		void StripComments(FAnsiStringView Text, TArray<ANSICHAR>& Out)
+		{
+			Out.SetNumUninitialized(Text.Len());
+			const ANSICHAR* P = Text.GetData();
+			ANSICHAR* Dst = Out.GetData();
+			const ANSICHAR* const End = P + Text.Len();
+
+			while (P < End)
+			{
+				if (*P == '"' || *P == '\'')
+				{
+					const ANSICHAR Quote = *P;
+					*Dst++ = *P++;
+					while (P < End && *P != Quote && *P != '\n')
+					{
+						if (*P == '\\' && P + 1 < End) *Dst++ = *P++;
+						*Dst++ = *P++;
+					}
+					if (P < End && *P == Quote) *Dst++ = *P++;
+				}
+				else if (*P == '/' && P + 1 < End && P[1] == '/')
+				{
+					while (P < End && *P != '\n') { *Dst++ = ' '; ++P; }
+				}
+				else if (*P == '/' && P + 1 < End && P[1] == '*')
+				{
+					*Dst++ = ' '; *Dst++ = ' '; P += 2;
+					while (P < End && !(*P == '*' && P + 1 < End && P[1] == '/'))
+					{
+						*Dst++ = (*P == '\n') ? '\n' : ' ';
+						++P;
+					}
+					for (int32 i = 0; i < 2 && P < End; ++i) { *Dst++ = ' '; ++P; }
+				}
+				else
+				{
+					*Dst++ = *P++;
+				}
+			}
+		}
+	}
+
+	TMap<uint64, int32> BuildHeaderIndex(const TArray<FScanPlugin>& Plugins, const TBitArray<>& Skip,
+		const FScanContext& Ctx)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(PluginScan_BuildHeaderIndex);
+
+		static const FStringView IncludeRoots[] = { TEXTVIEW("/Public/"), TEXTVIEW("/Classes/"), TEXTVIEW("/Internal/") };
+
+		TArray<TArray<uint64>> PerPlugin;
+		PerPlugin.SetNum(Plugins.Num());
+
+		IPlatformFile& PF = FPlatformFileManager::Get().GetPlatformFile();
+		ParallelFor(Plugins.Num(), [&](int32 PlgIdx)
+			{
+				if (Skip[PlgIdx] || Plugins[PlgIdx].Modules.IsEmpty() || Ctx.IsCancelled())
+					return;
+
+				const FString SourceRoot = FPaths::Combine(Plugins[PlgIdx].BaseDir, TEXT("Source"));
+				PF.IterateDirectoryRecursively(*SourceRoot, [&](const TCHAR* Path, bool bIsDir)
+					{
+						const FStringView View(Path);
+						if (bIsDir || !IsHeader(View))
+							return true;
+
+						for (const FStringView Root : IncludeRoots)
+						{
+							const int32 Pos = View.Find(Root, SourceRoot.Len(), ESearchCase::IgnoreCase);
+							if (Pos != INDEX_NONE)
+							{
+								PerPlugin[PlgIdx].Add(HashIncludePath(View.RightChop(Pos + Root.Len())));
+								break;
+							}
+						}
+						return true;
+					});
+			});
+
+		TMap<uint64, int32> Index;
+		for (int32 PlgIdx = 0; PlgIdx < PerPlugin.Num(); ++PlgIdx)
+		{
+			for (const uint64 Hash : PerPlugin[PlgIdx])
+				Index.FindOrAdd(Hash, PlgIdx);
+		}
+		return Index;
+	}
+
+	int32 FIncludeIndex::FindPluginHeader(uint64 Hash) const
+	{
+		if (const int32* PlgIdx = PluginHeaders.Find(Hash))
+			return *PlgIdx;
+
+		// plugins do scan que a base cobre não entraram em PluginHeaders
+		if (Layer && Layer->Base)
+		{
+			const int32* BaseIdx = Layer->Base->Headers.Find(Hash);
+			if (BaseIdx && Layer->BaseToLocal.IsValidIndex(*BaseIdx))
+				return Layer->BaseToLocal[*BaseIdx];
+		}
+		return INDEX_NONE;
+	}
+
+	// Literais de string de cada "...ModuleNames.Add/AddRange(...)" até o ';'
+	void ParseBuildCs(FAnsiStringView RawText, const FPluginModuleResolver& Resolver,
+		FPluginEvidenceIndex* Evidence, FName File, TBitArray<>& OutUsed)
+	{
+		// módulo comentado não é dependência
+		TArray<ANSICHAR> Stripped;
+		StripComments(RawText, Stripped);
+		const FAnsiStringView Text(Stripped.GetData(), Stripped.Num());
+
+		int32 Pos = 0;
+		while ((Pos = Text.Find("ModuleNames", Pos)) != INDEX_NONE)
+		{
+			int32 End = Text.Find(";", Pos);
+			if (End == INDEX_NONE) End = Text.Len();
+
+			for (int32 Open = Text.Find("\"", Pos); Open != INDEX_NONE && Open < End; )
+			{
+				const int32 Close = Text.Find("\"", Open + 1);
+				if (Close == INDEX_NONE || Close > End)
+					break;
+
+				const FAnsiStringView Module = Text.Mid(Open + 1, Close - Open - 1);
+				MarkUsedWith(FindModule(Resolver, Module), OutUsed, Evidence, [&](FPluginEvidenceIndex& Index, int32 PlgIdx)
+					{
+						Index.Add(PlgIdx, EPluginEvidenceKind::SourceFile, File, MakeEvidenceName(Module));
+					});
+				Open = Text.Find("\"", Close + 1);
+			}
+			Pos = End;
+		}
+	}
+
+	// #include "X" / <X> no começo de linha, fora de /* */ e de #if 0
+	void ParseIncludes(FAnsiStringView RawText, const FPluginModuleResolver& Resolver, const FIncludeIndex& Includes,
+		FStringView IncludingDir, FPluginEvidenceIndex* Evidence, FName File, TBitArray<>& OutUsed)
+	{
+		// a cópia só é necessária se há comentário de bloco
+		TArray<ANSICHAR> Stripped;
+		FAnsiStringView Text = RawText;
+		if (RawText.Find("/*") != INDEX_NONE)
+		{
+			StripComments(RawText, Stripped);
+			Text = FAnsiStringView(Stripped.GetData(), Stripped.Num());
+		}
+
+		const ANSICHAR* P = Text.GetData();
+		const ANSICHAR* const End = P + Text.Len();
+
+		auto SkipBlanks = [&]() { while (P < End && (*P == ' ' || *P == '\t')) ++P; };
+		auto IsWord = [&](const char* Word, int32 Len)
+			{
+				return End - P >= Len && FCStringAnsi::Strncmp(P, Word, Len) == 0
+					&& (End - P == Len || !FChar::IsIdentifier(TCHAR(P[Len])));
+			};
+
+		// > 0 dentro de #if 0: profundidade dos #if abertos desde ele
+		int32 DisabledDepth = 0;
+
+		while (P < End)
+		{
+			SkipBlanks();
+			if (P < End && *P == '#')
+			{
+				++P;
+				SkipBlanks();
+				if (DisabledDepth > 0)
+				{
+					if (IsWord("if", 2) || IsWord("ifdef", 5) || IsWord("ifndef", 6))
+						++DisabledDepth;
+					else if (IsWord("endif", 5))
+						--DisabledDepth;
+					else if (DisabledDepth == 1 && (IsWord("else", 4) || IsWord("elif", 4)))
+						DisabledDepth = 0;
+				}
+				else if (IsWord("if", 2))
+				{
+					P += 2;
+					SkipBlanks();
+					if (P < End && *P == '0' && (P + 1 == End || !FChar::IsIdentifier(TCHAR(P[1]))))
+						DisabledDepth = 1;
+				}
+				else if (End - P > 7 && FCStringAnsi::Strncmp(P, "include", 7) == 0)
+				{
+					P += 7;
+					SkipBlanks();
+					if (P < End && (*P == '"' || *P == '<'))
+					{
+						const ANSICHAR Closer = (*P == '"') ? '"' : '>';
+						const ANSICHAR* const Begin = ++P;
+						while (P < End && *P != Closer && *P != '\n') ++P;
+
+						const FAnsiStringView Include(Begin, int32(P - Begin));
+
+						// "Types.h" do próprio projeto não é o header de mesmo nome de um plugin
+						int32 Owner = INDEX_NONE;
+						if (!IsLocalInclude(Include, Includes.LocalHeaders, IncludingDir))
+						{
+							Owner = Includes.FindPluginHeader(HashIncludePath(Include));
+							if (Owner == INDEX_NONE)
+							{
+								// "Module/..." ou "Module.h"
+								int32 Cut = INDEX_NONE;
+								if (!Include.FindChar('/', Cut)) Include.FindLastChar('.', Cut);
+								if (Cut != INDEX_NONE)
+									Owner = FindModule(Resolver, Include.Left(Cut));
+							}
+						}
+
+						MarkUsedWith(Owner, OutUsed, Evidence, [&](FPluginEvidenceIndex& Index, int32 PlgIdx)
+							{
+								Index.Add(PlgIdx, EPluginEvidenceKind::SourceFile, File, MakeEvidenceName(Include));
+							});
+					}
+				}
+			}
+
+			// próxima linha
+			while (P < End && *P != '\n') ++P;
+			if (P < End) ++P;
+		}
+	}
+
+	bool ScanProjectSource(const FString& SourceDir, const TArray<FScanPlugin>& Plugins,
+		const FPluginModuleResolver& Resolver, const TBitArray<>& SkipUsed,
+		const FScanContext& Ctx, TBitArray<>& InOutUsed, const FPluginBaseLayer* Layer)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(PluginScan_ProjectSource);
+		IPlatformFile& PF = FPlatformFileManager::Get().GetPlatformFile();
+
+		TArray<FString> Files;
+		PF.IterateDirectoryRecursively(*SourceDir, [&Files](const TCHAR* Path, bool bIsDir)
+			{
+				if (!bIsDir && IsSourceFile(Path))
+					Files.Add(Path);
+				return true;
+			});
+
+		FPluginScanCounters Counters;
+		Counters.SourceFiles = Files.Num();
+		Ctx.AddCounters(Counters);
+
+		if (Files.IsEmpty())
+			return !Ctx.IsCancelled();
+
+		// com base (batch), só os plugins que ela não cobre são varridos aqui
+		TBitArray<> Skip = SkipUsed;
+		if (Layer && Layer->Base)
+			Skip.CombineWithBitwiseOR(Layer->Covered, EBitwiseOperatorFlags::MaintainSize);
+
+		FIncludeIndex Includes;
+		Includes.PluginHeaders = BuildHeaderIndex(Plugins, Skip, Ctx);
+		Includes.Layer = Layer;
+		if (Ctx.IsCancelled())
+			return false;
+		Includes.LocalHeaders = BuildLocalHeaderIndex(Files);
+
+		// arquivos pesam mais que assets: chunks bem menores
+		return ParallelClassify(Files.Num(), Plugins.Num(), EPluginScanPhase::ProjectSource, Ctx, InOutUsed,
+			[&](int32 FileIdx, FChunkState& State)
+			{
+				const FString& Path = Files[FileIdx];
+				FPluginEvidenceIndex* Evidence = State.Scratch.Evidence;
+				const FName File = Evidence ? FName(*FPaths::GetCleanFilename(Path)) : NAME_None;
+
+				VisitMappedFile(PF, Path, [&](FAnsiStringView Text)
+					{
+						if (IsBuildCs(Path))
+							ParseBuildCs(Text, Resolver, Evidence, File, State.Used);
+						else
+							ParseIncludes(Text, Resolver, Includes, FPaths::GetPath(FPaths::ConvertRelativePathToFull(Path)),
+								Evidence, File, State.Used);
+					});
+			}, 32);
+	}
+}
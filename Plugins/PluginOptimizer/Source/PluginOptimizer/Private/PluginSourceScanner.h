@@ -0,0 +1,48 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PluginScanCommon.h"
+
+/*
+ * Passada de código: lê as listas de módulos dos *.Build.cs e os #include do
+ * Source/ do projeto (arquivos mapeados em memória, em paralelo) e atribui
+ * cada referência ao plugin dono do módulo ou do header.
+ */
+namespace PluginScan
+{
+	// SkipUsed: plugins que já têm motivo de uso não precisam entrar no índice
+	// de headers (a parte cara: varrer o Source/ de cada plugin). Com Layer, os
+	// headers dos plugins cobertos pela base vêm de Base->Headers, sem varrer.
+	// Retorna false se foi cancelado.
+	bool ScanProjectSource(const FString& SourceDir, const TArray<FScanPlugin>& Plugins,
+		const FPluginModuleResolver& Resolver, const TBitArray<>& SkipUsed,
+		const FScanContext& Ctx, TBitArray<>& InOutUsed, const FPluginBaseLayer* Layer = nullptr);
+
+	// Caminho de include (hash) -> plugin, a partir das pastas Public/Classes/Internal
+	// de cada módulo, menos os plugins em Skip. Um header que existe em dois plugins
+	// fica com o primeiro
+	TMap<uint64, int32> BuildHeaderIndex(const TArray<FScanPlugin>& Plugins, const TBitArray<>& Skip,
+		const FScanContext& Ctx);
+
+	// O que resolve um #include: headers dos plugins do scan (e, com Layer, os
+	// da base) e os do próprio projeto, que ganham de qualquer plugin
+	struct FIncludeIndex
+	{
+		TMap<uint64, int32> PluginHeaders;
+		const FPluginBaseLayer* Layer = nullptr;
+		TSet<uint64> LocalHeaders;              // cada sufixo de caminho e o caminho completo
+
+		// INDEX_NONE se nenhum plugin do scan tem esse header
+		int32 FindPluginHeader(uint64 Hash) const;
+	};
+
+	// Módulos das listas "...ModuleNames" de um Build.cs (fora de comentários)
+	void ParseBuildCs(FAnsiStringView Text, const FPluginModuleResolver& Resolver,
+		FPluginEvidenceIndex* Evidence, FName File, TBitArray<>& OutUsed);
+
+	// #include de um .h/.cpp, fora de /* */ e de blocos #if 0; sem headers de
+	// plugin em Includes, só "Module/...". Includes que acham um header do projeto
+	// (LocalHeaders, ou relativos a IncludingDir) não contam: o local ganha
+	void ParseIncludes(FAnsiStringView Text, const FPluginModuleResolver& Resolver, const FIncludeIndex& Includes,
+		FStringView IncludingDir, FPluginEvidenceIndex* Evidence, FName File, TBitArray<>& OutUsed);
+}
@@ -0,0 +1,204 @@
+#include "PluginSyntheticRegistry.h"
+
+#include "Math/RandomStream.h"
+
+namespace
+{
+	const FName NativeParentClassTag("NativeParentClass");
+	const FName InterfacesTag("ImplementedInterfaces");
+
+	FAssetData MakeAsset(FName PackageName, FName PackagePath, FName AssetName, FAssetDataTagMap&& Tags)
+	{
+#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 1
+		return FAssetData(PackageName, PackagePath, AssetName, FName("Blueprint"), MoveTemp(Tags));
+#else
+		static const FTopLevelAssetPath BlueprintClass(TEXT("/Script/Engine"), TEXT("Blueprint"));
+		return FAssetData(PackageName, PackagePath, AssetName, BlueprintClass, MoveTemp(Tags));
+#endif
+	}
+
+	// índice do pacote -> semente das suas dependências
+	int32 PackageSeed(int32 Seed, int32 PackageIdx)
+	{
+		return int32(HashCombine(uint32(Seed), uint32(PackageIdx) * 2654435761u));
+	}
+}
+
+FSyntheticScanSource::FSyntheticScanSource(const FSyntheticRegistrySettings& InSettings)
+	: Settings(InSettings)
+{
+	FRandomStream Random(Settings.Seed);
+
+	// ------------------ plugins ------------------
+	Plugins.SetNum(Settings.NumPlugins);
+	ClassPaths.SetNum(Settings.NumPlugins);
+	PluginAssets.SetNum(Settings.NumPlugins);
+	ExpectedUsed.Init(false, Settings.NumPlugins);
+
+	// dependências de descritor por índice, para propagar o uso no fim
+	TArray<TArray<int32>> PluginDeps;
+	PluginDeps.SetNum(Settings.NumPlugins);
+
+	for (int32 PlgIdx = 0; PlgIdx < Settings.NumPlugins; ++PlgIdx)
+	{
+		PluginScan::FScanPlugin& P = Plugins[PlgIdx];
+		P.Name = FString::Printf(TEXT("BenchPlugin%d"), PlgIdx);
+		P.MountPath = FString::Format(*Settings.MountPathFormat, { PlgIdx });
+		P.Modules.Add(FName(*FString::Printf(TEXT("BenchModule%d"), PlgIdx)));
+		P.ModuleTypes.Add(EHostType::Runtime);
+		P.ModulePhases.Add(ELoadingPhase::Default);
+		P.ModuleFilters.AddDefaulted();
+
+		// só para trás: o grafo fica acíclico
+		if (PlgIdx > 0 && Random.FRand() < Settings.PluginDependencyRatio)
+		{
+			const int32 NumDeps = Random.RandRange(1, 2);
+			for (int32 i = 0; i < NumDeps; ++i)
+			{
+				const int32 DepIdx = Random.RandHelper(PlgIdx);
+				P.Dependencies.AddUnique(Plugins[DepIdx].Name);
+				PluginDeps[PlgIdx].Add(DepIdx);
+			}
+		}
+
+		ClassPaths[PlgIdx] = FName(*FString::Printf(TEXT("/Script/BenchModule%d.BenchClass"), PlgIdx));
+
+		FString Mount = P.MountPath;
+		MountToPlugin.Add(FName(*Mount), PlgIdx);
+		Mount.RemoveFromEnd(TEXT("/"));
+		MountToPlugin.Add(FName(*Mount), PlgIdx);
+
+		const FName MountName(*Mount);
+		for (int32 AssetIdx = 0; AssetIdx < Settings.AssetsPerPlugin; ++AssetIdx)
+		{
+			const FString AssetName = FString::Printf(TEXT("PluginAsset_%d"), AssetIdx);
+			PluginAssets[PlgIdx].Add(MakeAsset(FName(*(Mount / AssetName)), MountName, FName(*AssetName), FAssetDataTagMap()));
+		}
+	}
+
+	// ------------------ /Game ------------------
+	static const FName GamePath("/Game/Bench");
+	GameAssets.Reserve(Settings.NumAssets);
+
+	for (int32 AssetIdx = 0; AssetIdx < Settings.NumAssets; )
+	{
+		const int32 PackageIdx = GamePackages.Num();
+		const FName PackageName(*FString::Printf(TEXT("/Game/Bench/Pkg_%d"), PackageIdx));
+		GamePackages.Add(PackageName);
+		GamePackageIndex.Add(PackageName, PackageIdx);
+
+		const int32 NumInPackage = FMath::Min(Random.RandRange(1, FMath::Max(1, Settings.AssetsPerPackage * 2 - 1)),
+			Settings.NumAssets - AssetIdx);
+		for (int32 i = 0; i < NumInPackage; ++i, ++AssetIdx)
+		{
+			FAssetDataTagMap Tags;
+			if (Random.FRand() < Settings.ClassTagRatio)
+			{
+				const int32 PlgIdx = PickPlugin(Random);
+				ExpectedUsed[PlgIdx] = true;
+				Tags.Add(NativeParentClassTag, FString::Printf(TEXT("/Script/CoreUObject.Class'%s'"),
+					*ClassPaths[PlgIdx].ToString()));
+			}
+			if (Random.FRand() < Settings.InterfaceTagRatio)
+			{
+				const int32 PlgIdx = PickPlugin(Random);
+				ExpectedUsed[PlgIdx] = true;
+				Tags.Add(InterfacesTag, FString::Printf(TEXT("((Interface=/Script/CoreUObject.Class'%s',PointerOffset=0))"),
+					*ClassPaths[PlgIdx].ToString()));
+			}
+			GameAssets.Add(MakeAsset(PackageName, GamePath, FName(*FString::Printf(TEXT("Asset_%d"), AssetIdx)), MoveTemp(Tags)));
+		}
+	}
+
+	// ------------------ referencers de conteúdo de plugin ------------------
+	TArray<FName> Deps;
+	for (int32 PackageIdx = 0; PackageIdx < GamePackages.Num(); ++PackageIdx)
+	{
+		Deps.Reset();
+		GenerateDependencies(PackageIdx, Deps, &ExpectedUsed);
+		for (const FName Dep : Deps)
+		{
+			if (!GamePackageIndex.Contains(Dep))
+				PluginReferencers.FindOrAdd(Dep).Add(GamePackages[PackageIdx]);
+		}
+	}
+
+	// dependências só apontam para trás: uma passada decrescente fecha o conjunto
+	for (int32 PlgIdx = Settings.NumPlugins - 1; PlgIdx >= 0; --PlgIdx)
+	{
+		if (ExpectedUsed[PlgIdx])
+		{
+			for (const int32 DepIdx : PluginDeps[PlgIdx])
+				ExpectedUsed[DepIdx] = true;
+		}
+	}
+}
+
+int32 FSyntheticScanSource::PickPlugin(FRandomStream& Random) const
+{
+	const float U = FMath::Pow(Random.FRand(), Settings.PluginSkew);
+	return FMath::Min(int32(U * Settings.NumPlugins), Settings.NumPlugins - 1);
+}
+
+void FSyntheticScanSource::GenerateDependencies(int32 PackageIdx, TArray<FName>& OutDependencies, TBitArray<>* OutPluginHits) const
+{
+	FRandomStream Random(PackageSeed(Settings.Seed, PackageIdx));
+	for (int32 i = 0; i < Settings.DependenciesPerPackage; ++i)
+	{
+		if (Settings.AssetsPerPlugin > 0 && Random.FRand() < Settings.PluginContentRatio)
+		{
+			const int32 PlgIdx = PickPlugin(Random);
+			const TArray<FAssetData>& Content = PluginAssets[PlgIdx];
+			OutDependencies.Add(Content[Random.RandHelper(Content.Num())].PackageName);
+			if (OutPluginHits)
+				(*OutPluginHits)[PlgIdx] = true;
+		}
+		else
+		{
+			OutDependencies.Add(GamePackages[Random.RandHelper(GamePackages.Num())]);
+		}
+	}
+}
+
+SIZE_T FSyntheticScanSource::GetAllocatedSize() const
+{
+	SIZE_T Size = GameAssets.GetAllocatedSize() + GamePackages.GetAllocatedSize() + GamePackageIndex.GetAllocatedSize()
+		+ PluginReferencers.GetAllocatedSize();
+	for (const TArray<FAssetData>& Content : PluginAssets)
+		Size += Content.GetAllocatedSize();
+	for (const TPair<FName, TArray<FName>>& Pair : PluginReferencers)
+		Size += Pair.Value.GetAllocatedSize();
+	return Size;
+}
+
+void FSyntheticScanSource::EnumerateAssetsByPath(FName Path, int32 BatchSize, FAssetBatchVisitor Visit) const
+{
+	// já agrupados por pacote: os lotes são fatias, sem cópia
+	if (Path == FName("/Game"))
+	{
+		VisitInBatches(GameAssets, BatchSize, Visit);
+	}
+	else if (const int32* PlgIdx = MountToPlugin.Find(Path))
+	{
+		VisitInBatches(PluginAssets[*PlgIdx], BatchSize, Visit);
+	}
+}
+
+void FSyntheticScanSource::GetDependencies(FName PackageName, TArray<FName>& OutDependencies) const
+{
+	if (const int32* PackageIdx = GamePackageIndex.Find(PackageName))
+		GenerateDependencies(*PackageIdx, OutDependencies);
+}
+
+void FSyntheticScanSource::GetReferencers(FName PackageName, TArray<FName>& OutReferencers) const
+{
+	if (const TArray<FName>* Refs = PluginReferencers.Find(PackageName))
+		OutReferencers.Append(*Refs);
+}
+
+FIoHash FSyntheticScanSource::GetPackageHash(FName PackageName) const
+{
+	// estável entre execuções: o cache por pacote vale de uma rodada para outra
+	const FString Name = PackageName.ToString();
+	return FIoHash::HashBuffer(*Name, Name.Len() * sizeof(TCHAR));
+}
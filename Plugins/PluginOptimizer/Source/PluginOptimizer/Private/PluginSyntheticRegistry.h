@@ -0,0 +1,77 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PluginScanSource.h"
+#include "PluginScanCommon.h"
+#include "AssetRegistry/AssetData.h"
+
+/* Formato do registry gerado; tudo é determinístico a partir de Seed */
+struct FSyntheticRegistrySettings
+{
+	int32 NumAssets = 10000;
+	int32 AssetsPerPackage = 2;             // média; sorteado entre 1 e 2x
+
+	int32 NumPlugins = 300;
+	int32 AssetsPerPlugin = 20;
+	FString MountPathFormat = TEXT("/BenchPlugin{0}/");     // {0} = índice do plugin
+
+	// Fração dos plugins que depende (descritor) de 1-2 plugins de índice menor
+	float PluginDependencyRatio = 0.1f;
+
+	// Tags por asset: NativeParentClass / ImplementedInterfaces apontando para módulo de plugin
+	float ClassTagRatio = 0.3f;
+	float InterfaceTagRatio = 0.05f;
+
+	// Dependências por pacote de /Game e fração delas que cai em conteúdo de plugin
+	int32 DependenciesPerPackage = 4;
+	float PluginContentRatio = 0.02f;
+
+	// > 1 concentra os hits nos primeiros plugins, deixando a cauda sem uso
+	float PluginSkew = 2.f;
+
+	int32 Seed = 1234;
+};
+
+/*
+ * Registry sintético para o benchmark. Os assets de /Game ficam em memória;
+ * as dependências de cada pacote são geradas sob demanda a partir do índice
+ * do pacote (mesmo resultado a cada consulta, sem guardar a lista), e só os
+ * referencers de conteúdo de plugin são materializados. O gerador anota
+ * quais plugins recebem referência (mais as dependências de descritor
+ * deles): é o resultado correto que um scan completo tem que encontrar.
+ */
+class FSyntheticScanSource final : public IPluginScanSource
+{
+public:
+	explicit FSyntheticScanSource(const FSyntheticRegistrySettings& InSettings);
+
+	const TArray<PluginScan::FScanPlugin>& GetPlugins() const { return Plugins; }
+	int32 GetNumPackages() const { return GamePackages.Num(); }
+	const TBitArray<>& GetExpectedUsed() const { return ExpectedUsed; }
+	SIZE_T GetAllocatedSize() const;
+
+	virtual bool IsLoading() const override { return false; }
+	virtual void EnumerateAssetsByPath(FName Path, int32 BatchSize, FAssetBatchVisitor Visit) const override;
+	virtual void GetDependencies(FName PackageName, TArray<FName>& OutDependencies) const override;
+	virtual void GetReferencers(FName PackageName, TArray<FName>& OutReferencers) const override;
+	virtual FIoHash GetPackageHash(FName PackageName) const override;
+
+private:
+	int32 PickPlugin(FRandomStream& Random) const;
+	void GenerateDependencies(int32 PackageIdx, TArray<FName>& OutDependencies, TBitArray<>* OutPluginHits = nullptr) const;
+
+	FSyntheticRegistrySettings Settings;
+
+	TArray<PluginScan::FScanPlugin> Plugins;
+	TArray<FName> ClassPaths;               // por plugin: "/Script/BenchModuleN.BenchClass"
+
+	TArray<FName> GamePackages;
+	TMap<FName, int32> GamePackageIndex;
+	TArray<FAssetData> GameAssets;
+
+	TArray<TArray<FAssetData>> PluginAssets;
+	TMap<FName, int32> MountToPlugin;       // com e sem a barra final
+	TMap<FName, TArray<FName>> PluginReferencers;
+
+	TBitArray<> ExpectedUsed;
+};
@@ -0,0 +1,112 @@
+#include "PluginTargetAnalysis.h"
+#include "PluginDependencyGraph.h"
+
+namespace PluginScan
+{
+	namespace
+	{
+		EBuildTargetType ToBuildTargetType(EPluginBuildTarget Target)
+		{
+			switch (Target)
+			{
+			case EPluginBuildTarget::Client: return EBuildTargetType::Client;
+			case EPluginBuildTarget::Server: return EBuildTargetType::Server;
+			default:                         return EBuildTargetType::Game;
+			}
+		}
+
+		bool ContainsPlatform(const TArray<FString>& List, const FString& Platform)
+		{
+			return List.ContainsByPredicate([&Platform](const FString& P) { return P.Equals(Platform, ESearchCase::IgnoreCase); });
+		}
+	}
+
+	bool IsModuleInTarget(EHostType::Type Type, const FModuleTargetFilter& Filter,
+		EPluginBuildTarget Target, const FString& Platform)
+	{
+		// ModuleDescriptor.IsCompiledInConfiguration do UBT, na mesma ordem
+		if ((Filter.bHasExplicitPlatforms || Filter.PlatformAllowList.Num()) && !ContainsPlatform(Filter.PlatformAllowList, Platform))
+			return false;
+		if (ContainsPlatform(Filter.PlatformDenyList, Platform))
+			return false;
+
+		const EBuildTargetType TargetType = ToBuildTargetType(Target);
+		if (Filter.TargetAllowList.Num() && !Filter.TargetAllowList.Contains(TargetType))
+			return false;
+		if (Filter.TargetDenyList.Contains(TargetType))
+			return false;
+
+		if (Filter.ConfigurationAllowList.Num() && !Filter.ConfigurationAllowList.Contains(EBuildConfiguration::Shipping))
+			return false;
+		if (Filter.ConfigurationDenyList.Contains(EBuildConfiguration::Shipping))
+			return false;
+
+		switch (Type)
+		{
+		case EHostType::Runtime:
+		case EHostType::RuntimeNoCommandlet:
+		case EHostType::RuntimeAndProgram:
+		case EHostType::CookedOnly:
+			return true;
+
+		case EHostType::ClientOnly:
+		case EHostType::ClientOnlyNoCommandlet:
+			return Target != EPluginBuildTarget::Server;
+
+		case EHostType::ServerOnly:
+			return Target != EPluginBuildTarget::Client;
+
+		default:
+			return false;
+		}
+	}
+
+	bool IsPluginOnPlatform(const FScanPlugin& Plugin, const FString& Platform)
+	{
+		return !(Plugin.bHasExplicitPlatforms || Plugin.SupportedTargetPlatforms.Num())
+			|| ContainsPlatform(Plugin.SupportedTargetPlatforms, Platform);
+	}
+
+	void BuildTargetReports(const TArray<FScanPlugin>& Plugins, const FPluginDependencyGraph& Graph,
+		const FString& Platform, FPluginScanResult& Out)
+	{
+		TRACE_CPUPROFILER_EVENT_SCOPE(PluginScan_TargetReports);
+
+		const int32 N = Plugins.Num();
+
+		// usado em runtime segura suas dependências, como no used-set do editor
+		TBitArray<> RuntimeUsed(false, N);
+		for (int32 Idx = 0; Idx < N; ++Idx)
+			RuntimeUsed[Idx] = EnumHasAnyFlags(Out.UsageReasons[Idx], RuntimeUsageReasons);
+		Graph.PropagateUsed(RuntimeUsed);
+
+		const FString TargetPlatform = Platform.IsEmpty() ? FString(FPlatformMisc::GetUBTPlatform()) : Platform;
+
+		Out.TargetReports.Reset();
+		for (uint8 T = 0; T < uint8(EPluginBuildTarget::Num); ++T)
+		{
+			FPluginTargetReport& Report = Out.TargetReports.AddDefaulted_GetRef();
+			Report.Target = EPluginBuildTarget(T);
+			Report.Platform = TargetPlatform;
+
+			for (int32 Idx = 0; Idx < N; ++Idx)
+			{
+				const FScanPlugin& P = Plugins[Idx];
+				if (RuntimeUsed[Idx] || !IsPluginOnPlatform(P, TargetPlatform))
+					continue;
+
+				TArray<FPluginShippedModule> Shipped;
+				for (int32 M = 0; M < P.Modules.Num(); ++M)
+				{
+					if (IsModuleInTarget(P.ModuleTypes[M], P.ModuleFilters[M], Report.Target, TargetPlatform))
+						Shipped.Add({ P.Modules[M], P.ModuleTypes[M], P.ModulePhases[M] });
+				}
+
+				if (Shipped.Num())
+					Report.Strippable.Add({ P.Name, MoveTemp(Shipped) });
+			}
+
+			Report.Strippable.Sort([](const FPluginStrippable& A, const FPluginStrippable& B) { return A.Plugin < B.Plugin; });
+		}
+	}
+}
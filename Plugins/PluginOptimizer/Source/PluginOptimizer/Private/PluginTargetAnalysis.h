@@ -0,0 +1,24 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PluginScanCommon.h"
+
+class FPluginDependencyGraph;
+
+namespace PluginScan
+{
+	// O módulo entra no alvo em Shipping para Platform (nome UBT)? Mesmas regras
+	// do UBT: listas de alvo, plataforma e configuração do descritor, depois o
+	// ModuleHostType (Developer/DeveloperTool, Editor/UncookedOnly/Program ficam de fora)
+	bool IsModuleInTarget(EHostType::Type Type, const FModuleTargetFilter& Filter,
+		EPluginBuildTarget Target, const FString& Platform);
+
+	// SupportedTargetPlatforms do plugin inclui Platform?
+	bool IsPluginOnPlatform(const FScanPlugin& Plugin, const FString& Platform);
+
+	// Com UsageReasons já preenchido: um relatório por alvo com os plugins que
+	// levam módulos para o build sem nenhum motivo de runtime (RuntimeUsageReasons)
+	// neles ou em quem depende deles. Platform vazio = a do editor
+	void BuildTargetReports(const TArray<FScanPlugin>& Plugins, const FPluginDependencyGraph& Graph,
+		const FString& Platform, FPluginScanResult& Out);
+}
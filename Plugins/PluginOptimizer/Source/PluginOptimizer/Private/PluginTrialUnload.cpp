@@ -0,0 +1,332 @@
+#include "PluginTrialUnload.h"
+#include "PluginDisableBatch.h"
+#include "PluginPackageImports.h"
+#include "PluginScanCommon.h"
+#include "PluginScanSource.h"
+
+#include "Interfaces/IPluginManager.h"
+#include "AssetRegistry/IAssetRegistry.h"
+#include "Modules/ModuleManager.h"
+#include "Async/ParallelFor.h"
+#include "AssetRegistry/AssetData.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "HAL/PlatformMemory.h"
+#include "PackageTools.h"
+#include "UObject/Package.h"
+#include "UObject/UObjectIterator.h"
+#include "UObject/UObjectGlobals.h"
+#include "Algo/StableSort.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+
+#define LOCTEXT_NAMESPACE "PluginTrialUnload"
+
+namespace
+{
+	// Coleta + devolução ao SO, para as duas medições serem comparáveis
+	uint64 MeasureUsedPhysical()
+	{
+		CollectGarbage(GARBAGE_COLLECTION_KEEPFLAGS, true);
+		FMemory::Trim();
+		return FPlatformMemory::GetStats().UsedPhysical;
+	}
+
+	// Dependentes antes das dependências (só arestas dentro do conjunto)
+	TArray<TSharedRef<IPlugin>> SortForUnload(const TArray<TSharedRef<IPlugin>>& InPlugins)
+	{
+		TMap<FString, int32> Index;
+		for (int32 Idx = 0; Idx < InPlugins.Num(); ++Idx)
+			Index.Add(InPlugins[Idx]->GetName(), Idx);
+
+		// Dependents[B] = quem no conjunto precisa de B
+		TArray<TArray<int32>> Dependents;
+		TArray<int32> PendingDependents;
+		Dependents.SetNum(InPlugins.Num());
+		PendingDependents.SetNumZeroed(InPlugins.Num());
+		for (int32 Idx = 0; Idx < InPlugins.Num(); ++Idx)
+		{
+			for (const FPluginReferenceDescriptor& Dep : InPlugins[Idx]->GetDescriptor().Plugins)
+			{
+				const int32* DepIdx = Index.Find(Dep.Name);
+				if (Dep.bEnabled && DepIdx && *DepIdx != Idx)
+				{
+					Dependents[*DepIdx].Add(Idx);
+					++PendingDependents[*DepIdx];
+				}
+			}
+		}
+
+		// Kahn ao contrário: sai primeiro quem não tem dependente pendente
+		TArray<int32> Ready;
+		for (int32 Idx = 0; Idx < InPlugins.Num(); ++Idx)
+			if (PendingDependents[Idx] == 0) Ready.Add(Idx);
+
+		TArray<TSharedRef<IPlugin>> Sorted;
+		TBitArray<> Done(false, InPlugins.Num());
+		while (Ready.Num())
+		{
+			const int32 Idx = Ready.Pop();
+			Done[Idx] = true;
+			Sorted.Add(InPlugins[Idx]);
+			for (const FPluginReferenceDescriptor& Dep : InPlugins[Idx]->GetDescriptor().Plugins)
+			{
+				const int32* DepIdx = Index.Find(Dep.Name);
+				if (Dep.bEnabled && DepIdx && *DepIdx != Idx && --PendingDependents[*DepIdx] == 0)
+					Ready.Add(*DepIdx);
+			}
+		}
+
+		// ciclo (descritor inválido): o resto vai na ordem original
+		for (int32 Idx = 0; Idx < InPlugins.Num(); ++Idx)
+			if (!Done[Idx]) Sorted.Add(InPlugins[Idx]);
+		return Sorted;
+	}
+}
+
+FPluginTrialUnload::~FPluginTrialUnload()
+{
+	if (bActive)
+		Restore();
+}
+
+bool FPluginTrialUnload::Begin(const TArray<FString>& PluginNames, FText& OutFailReason)
+{
+	check(IsInGameThread());
+	check(!bActive);
+
+	// mesmas regras da desativação: quem fica não pode depender de quem sai
+	if (!FPluginDisableBatch::Validate(PluginNames, OutFailReason))
+		return false;
+
+	IPluginManager& PluginMgr = IPluginManager::Get();
+	TArray<TSharedRef<IPlugin>> Targets;
+	for (const FString& Name : PluginNames)
+		Targets.Add(PluginMgr.FindPlugin(Name).ToSharedRef());
+
+	// conteúdo carregado dos plugins sai da memória antes do unmount
+	TArray<UPackage*> LoadedContent;
+	for (const TSharedRef<IPlugin>& Plugin : Targets)
+	{
+		if (!Plugin->CanContainContent())
+			continue;
+
+		const FString Root = Plugin->GetMountedAssetPath();
+		for (TObjectIterator<UPackage> It; It; ++It)
+		{
+			if (!It->GetName().StartsWith(Root))
+				continue;
+			if (It->IsDirty())
+			{
+				OutFailReason = FText::Format(LOCTEXT("Dirty", "{0} has unsaved changes."), FText::FromString(It->GetName()));
+				return false;
+			}
+			LoadedContent.Add(*It);
+		}
+	}
+
+	// ------------------ o que sai: módulos (dependentes primeiro, fases de trás para frente) e raízes
+	TSet<FName> ScriptPackages;
+	TArray<FName> ToUnload;
+	FModuleManager& ModuleMgr = FModuleManager::Get();
+	for (const TSharedRef<IPlugin>& Plugin : SortForUnload(Targets))
+	{
+		TArray<const FModuleDescriptor*> Modules;
+		for (const FModuleDescriptor& Module : Plugin->GetDescriptor().Modules)
+			Modules.Add(&Module);
+		Algo::StableSortBy(Modules, [](const FModuleDescriptor* M) { return -int32(M->LoadingPhase); });
+
+		for (const FModuleDescriptor* Module : Modules)
+		{
+			const FString ScriptPath = TEXT("/Script/") + Module->Name.ToString();
+			ScriptPackages.Add(FName(*ScriptPath));
+
+			IModuleInterface* Loaded = ModuleMgr.GetModule(Module->Name);
+			if (!Loaded)
+				continue;
+
+			// UObjects de um módulo (classes, CDOs, instâncias) vivem no seu
+			// pacote /Script: com ele carregado, descarregar o código deixaria
+			// ponteiros soltos para o próximo GC. Só módulos sem UObject saem
+			if (FindPackage(nullptr, *ScriptPath) || !Loaded->SupportsDynamicReloading())
+				KeptLoaded.Add(Module->Name);
+			else
+				ToUnload.Add(Module->Name);
+		}
+	}
+
+	TArray<FMount> Mounts;
+	for (const TSharedRef<IPlugin>& Plugin : Targets)
+	{
+		if (Plugin->CanContainContent())
+			Mounts.Add({ Plugin->GetMountedAssetPath(), Plugin->GetContentDir() });
+	}
+
+	// antes de desmontar: o registry ainda tem as dependências para o conteúdo dos plugins
+	ValidateDependents(ScriptPackages, Mounts);
+
+	// ------------------ unload + medição ------------------
+	const uint64 Before = MeasureUsedPhysical();
+
+	if (LoadedContent.Num() && !UPackageTools::UnloadPackages(LoadedContent, OutFailReason))
+	{
+		BrokenPackages.Reset();
+		KeptLoaded.Reset();
+		return false;
+	}
+
+	Plugins = PluginNames;
+	bActive = true;
+
+	for (const FName Module : ToUnload)
+	{
+		if (ModuleMgr.UnloadModule(Module))
+			Unloaded.Add(Module);
+		else
+			KeptLoaded.Add(Module);
+	}
+
+	// conteúdo: sai do registry e do mapeamento de pacotes
+	IAssetRegistry& AR = PluginScan::GetAssetRegistry();
+	for (const FMount& Mount : Mounts)
+	{
+		AR.RemovePath(Mount.RootPath);
+		FPackageName::UnRegisterMountPoint(Mount.RootPath, Mount.ContentDir);
+	}
+	Unmounted = MoveTemp(Mounts);
+
+	ReclaimedBytes = int64(Before) - int64(MeasureUsedPhysical());
+	return true;
+}
+
+void FPluginTrialUnload::ValidateDependents(const TSet<FName>& ScriptPackages, const TArray<FMount>& Mounts)
+{
+	TRACE_CPUPROFILER_EVENT_SCOPE(PluginOptimizer_TrialValidate);
+
+	IAssetRegistry& AR = PluginScan::GetAssetRegistry();
+	const FAssetRegistryScanSource Source(AR);
+
+	// ------------------ dependências de /Game para o conteúdo que sai, em lotes
+	TArray<int32> AssetOrder;
+	Source.EnumerateAssetsByPath("/Game", FPluginScanOptions().AssetBatchSize, [&](TConstArrayView<FAssetData> Batch)
+		{
+			const TArray<PluginScan::FGamePackage> Packages = PluginScan::GroupByPackage(Batch, AssetOrder);
+			TArray<bool> Broken;
+			Broken.SetNumZeroed(Packages.Num());
+
+			ParallelFor(Packages.Num(), [&](int32 PkgIdx)
+				{
+					TArray<FName> Dependencies;
+					Source.GetDependencies(Packages[PkgIdx].Name, Dependencies);
+					for (const FName Dep : Dependencies)
+					{
+						TStringBuilder<256> DepStr;
+						DepStr << Dep;
+						if (Mounts.ContainsByPredicate([&](const FMount& M) { return DepStr.ToView().StartsWith(M.RootPath); }))
+						{
+							Broken[PkgIdx] = true;
+							return;
+						}
+					}
+				});
+
+			for (int32 PkgIdx = 0; PkgIdx < Packages.Num(); ++PkgIdx)
+				if (Broken[PkgIdx])
+					BrokenPackages.Add(Packages[PkgIdx].Name);
+			return true;
+		});
+
+	// ------------------ imports "/Script/" dos referencers, lidos do disco
+	// (o registry pode não listar import de código): o linker não os resolveria
+	// depois da desativação. Janelas de 16 leituras por worker, como na passada profunda
+	TSet<FName> Candidates;
+	TArray<FName> Referencers;
+	for (const FName Script : ScriptPackages)
+	{
+		Referencers.Reset();
+		AR.GetReferencers(Script, Referencers);
+		Candidates.Append(Referencers);
+	}
+
+	const TSet<FName> ByContent(BrokenPackages);
+	TArray<FName> ToRead;
+	TArray<FString> BasePaths;
+	for (const FName Pkg : Candidates)
+	{
+		FString Base;
+		if (!ByContent.Contains(Pkg) && Pkg.ToString().StartsWith(TEXT("/Game/"))
+			&& FPackageName::TryConvertLongPackageNameToFilename(Pkg.ToString(), Base))
+		{
+			ToRead.Add(Pkg);
+			BasePaths.Add(MoveTemp(Base));
+		}
+	}
+
+	constexpr int32 ReadWindow = 16;
+	TArray<bool> Imports;
+	Imports.SetNumZeroed(ToRead.Num());
+	ParallelFor(FMath::DivideAndRoundUp(ToRead.Num(), ReadWindow), [&](int32 WindowIdx)
+		{
+			const int32 First = WindowIdx * ReadWindow;
+			const int32 Num = FMath::Min(ReadWindow, ToRead.Num() - First);
+			PluginScan::ReadPackageImports(TConstArrayView<FString>(BasePaths.GetData() + First, Num),
+				[&](int32 ReadIdx, TConstArrayView<FName> ScriptImports)
+				{
+					for (const FName Script : ScriptImports)
+					{
+						if (ScriptPackages.Contains(Script))
+						{
+							Imports[First + ReadIdx] = true;
+							return;
+						}
+					}
+				});
+		});
+
+	for (int32 Idx = 0; Idx < ToRead.Num(); ++Idx)
+		if (Imports[Idx])
+			BrokenPackages.Add(ToRead[Idx]);
+
+	BrokenPackages.Sort(FNameLexicalLess());
+}
+
+void FPluginTrialUnload::Restore()
+{
+	if (!bActive)
+		return;
+	bActive = false;
+
+	IAssetRegistry& AR = PluginScan::GetAssetRegistry();
+	TArray<FString> Paths;
+	for (const FMount& Mount : Unmounted)
+	{
+		FPackageName::RegisterMountPoint(Mount.RootPath, Mount.ContentDir);
+		AR.AddPath(Mount.RootPath);
+		Paths.Add(Mount.RootPath);
+	}
+	if (Paths.Num())
+		AR.ScanPathsSynchronous(Paths, true);
+
+	// ordem inversa do unload: dependências antes dos dependentes
+	for (int32 Idx = Unloaded.Num() - 1; Idx >= 0; --Idx)
+		FModuleManager::Get().LoadModule(Unloaded[Idx]);
+
+	Unloaded.Reset();
+	Unmounted.Reset();
+}
+
+bool FPluginTrialUnload::Commit(FText& OutFailReason)
+{
+	check(bActive);
+
+	if (!FPluginDisableBatch::Apply(Plugins, OutFailReason))
+	{
+		Restore();
+		return false;
+	}
+
+	// desativado de fato: módulos e conteúdo ficam fora até o restart
+	bActive = false;
+	return true;
+}
+
+#undef LOCTEXT_NAMESPACE
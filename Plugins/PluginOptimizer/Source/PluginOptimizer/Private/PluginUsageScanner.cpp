@@ -1,131 +1,702 @@
 ﻿#include "PluginUsageScanner.h"
+#include "PluginScanCommon.h"
+#include "PluginScanCache.h"
+#include "PluginSourceScanner.h"
+#include "PluginConfigScanner.h"
+#include "PluginScanSource.h"
+#include "PluginDependencyGraph.h"
+#include "PluginPackageImports.h"
+#include "PluginMapReachability.h"
 
-#include "Interfaces/IPluginManager.h"
-#include "AssetRegistry/AssetRegistryModule.h"
 #include "AssetRegistry/IAssetRegistry.h"
 #include "AssetRegistry/AssetData.h"
 #include "Modules/ModuleManager.h"
+#include "Misc/Paths.h"
+#include "Async/Async.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformMemory.h"
+#include "Misc/ScopeExit.h"
+#include "HAL/LowLevelMemTracker.h"
+#include "ProfilingDebugging/CpuProfilerTrace.h"
+#include "ProfilingDebugging/CountersTrace.h"
+
+#define LOCTEXT_NAMESPACE "PluginUsageScanner"
+
+using namespace PluginScan;
+
+TRACE_DECLARE_INT_COUNTER(PluginScan_PackagesVisited, TEXT("PluginOptimizer/PackagesVisited"));
+TRACE_DECLARE_INT_COUNTER(PluginScan_AssetsVisited, TEXT("PluginOptimizer/AssetsVisited"));
+TRACE_DECLARE_INT_COUNTER(PluginScan_TagLookups, TEXT("PluginOptimizer/TagLookups"));
+TRACE_DECLARE_INT_COUNTER(PluginScan_DependencyQueries, TEXT("PluginOptimizer/DependencyQueries"));
 
 namespace
 {
-	// Converte “/Script/Module.Class”  ->  Module  ->  Plugin
-	void ConsiderClassPath(const FString& ClassPath,
-		const TMap<FString, FString>& ModuleToPlugin,
-		TSet<FString>& OutUsed)
+	// Tudo que invalida o cache inteiro: plugins, módulos, mounts e modo da passada 2
+	uint32 ComputeCacheSignature(const TArray<FScanPlugin>& Plugins, const FPluginScanOptions& Options)
+	{
+		TArray<const FScanPlugin*> Sorted;
+		for (const FScanPlugin& P : Plugins) Sorted.Add(&P);
+		Sorted.Sort([](const FScanPlugin& A, const FScanPlugin& B) { return A.Name < B.Name; });
+
+		uint32 Sig = GetTypeHash(uint8(Options.ReferencePass));
+		Sig = HashCombine(Sig, GetTypeHash(Options.bScanPackageImports));
+		for (const FScanPlugin* P : Sorted)
+		{
+			Sig = HashCombine(Sig, GetTypeHash(P->Name));
+			Sig = HashCombine(Sig, GetTypeHash(P->MountPath));
+			for (const FName M : P->Modules)
+				Sig = HashCombine(Sig, GetTypeHash(M.ToString()));
+		}
+		return Sig;
+	}
+
+	// Hits por pacote: o que vai pro cache e o que foi reaproveitado dele
+	struct FPackageHits
+	{
+		TArray<FPluginScanCacheEntry>        NewEntries;
+		TArray<const FPluginScanCacheEntry*> Cached;     // nullptr = pacote novo ou modificado
+	};
+
+	void MarkHits(const TArray<int32>& Hits, FName PackageName, FClassifyScratch& Scratch, TBitArray<>& OutUsed)
+	{
+		for (const int32 Idx : Hits)
+			MarkUsed(Idx, OutUsed, Scratch.Evidence, EPluginEvidenceKind::CachedPackage, PackageName);
+	}
+
+	// Passada 2 invertida: dependências de cada pacote /Game, classificadas pela raiz
+	// (pacotes em Uncached não usam nem alimentam o cache)
+	bool ScanGameDependencies(const TArray<FName>& Packages, const TBitArray<>& Uncached, const FPluginModuleResolver& Resolver,
+		int32 NumPlugins, const IPluginScanSource& Source, const FScanContext& Ctx, FPackageHits* Hits, TBitArray<>& InOutUsed)
+	{
+		return ParallelClassify(Packages.Num(), NumPlugins, EPluginScanPhase::PluginReferences, Ctx, InOutUsed,
+			[&](int32 PkgIdx, FChunkState& State)
+			{
+				FPackageHits* PkgHits = Uncached[PkgIdx] ? nullptr : Hits;
+				if (PkgHits && PkgHits->Cached[PkgIdx])
+				{
+					PkgHits->NewEntries[PkgIdx].DependencyHits = PkgHits->Cached[PkgIdx]->DependencyHits;
+					MarkHits(PkgHits->NewEntries[PkgIdx].DependencyHits, Packages[PkgIdx], State.Scratch, State.Used);
+					return;
+				}
+
+				ClassifyPackage(State, PkgHits ? &PkgHits->NewEntries[PkgIdx].DependencyHits : nullptr,
+					[&](TBitArray<>& Bits)
+					{
+						ClassifyPackageDependencies(Source, Packages[PkgIdx], Resolver, State.Scratch, Bits);
+					});
+			});
+	}
+
+	// Passada profunda: imports "/Script/" do header de cada pacote /Game, lidos em
+	// janelas de leituras assíncronas por worker (pacotes em Skip não são lidos)
+	bool ScanGameImports(const TArray<FName>& Packages, const TBitArray<>& Skip, const FString& ContentDir,
+		const FPluginModuleResolver& Resolver, int32 NumPlugins, const FScanContext& Ctx, FPackageHits* Hits, TBitArray<>& InOutUsed)
+	{
+		constexpr int32 ReadWindow = 16;    // leituras em voo por worker
+		const int32 NumWindows = FMath::DivideAndRoundUp(Packages.Num(), ReadWindow);
+
+		return ParallelClassify(NumWindows, NumPlugins, EPluginScanPhase::PackageImports, Ctx, InOutUsed,
+			[&](int32 WindowIdx, FChunkState& State)
+			{
+				const int32 First = WindowIdx * ReadWindow;
+				const int32 Last = FMath::Min(First + ReadWindow, Packages.Num());
+
+				TArray<int32, TInlineAllocator<ReadWindow>> ToRead;
+				TArray<FString, TInlineAllocator<ReadWindow>> BasePaths;
+				for (int32 PkgIdx = First; PkgIdx < Last; ++PkgIdx)
+				{
+					if (Skip[PkgIdx]) continue;
+					if (Hits && Hits->Cached[PkgIdx])
+					{
+						Hits->NewEntries[PkgIdx].ImportHits = Hits->Cached[PkgIdx]->ImportHits;
+						MarkHits(Hits->NewEntries[PkgIdx].ImportHits, Packages[PkgIdx], State.Scratch, State.Used);
+						continue;
+					}
+
+					// "/Game/A/B" -> <Content>/A/B
+					TStringBuilder<256> Name;
+					Name << Packages[PkgIdx];
+					ToRead.Add(PkgIdx);
+					BasePaths.Add(FPaths::Combine(ContentDir, Name.ToView().RightChop(6)));
+				}
+
+				ReadPackageImports(BasePaths, [&](int32 ReadIdx, TConstArrayView<FName> ScriptPackages)
+					{
+						const int32 PkgIdx = ToRead[ReadIdx];
+						++State.Scratch.Counters.PackageHeaders;
+						ClassifyPackage(State, Hits ? &Hits->NewEntries[PkgIdx].ImportHits : nullptr,
+							[&](TBitArray<>& Bits)
+							{
+								for (const FName Script : ScriptPackages)
+									MarkUsed(Resolver.FindByScriptPackage(Script), Bits, State.Scratch.Evidence,
+										EPluginEvidenceKind::PackageImport, Packages[PkgIdx], Script);
+							});
+					});
+			}, 8);
+	}
+
+	// Passada 2 original: referencers de cada asset de cada plugin
+	// (pula plugins que a passada 1 já marcou em SkipUsed)
+	bool ScanPluginReferencers(const TArray<FScanPlugin>& Plugins, const IPluginScanSource& Source, int32 BatchSize,
+		const FScanContext& Ctx, const TBitArray<>& SkipUsed, TBitArray<>& InOutUsed)
 	{
-		FString Left, Right;
-		if (!ClassPath.Split(TEXT("."), &Left, &Right)) return;
+		FPluginScanCounters Counters;
+		ON_SCOPE_EXIT{ Ctx.AddCounters(Counters); };
+
+		for (int32 PlgIdx = 0; PlgIdx < Plugins.Num(); ++PlgIdx)
+		{
+			if (Ctx.IsCancelled()) return false;
+			if (Ctx.CheckGoals(InOutUsed)) break;
+			Ctx.Report(EPluginScanPhase::PluginReferences, float(PlgIdx) / Plugins.Num());
 
-		const FString Prefix(TEXT("/Script/"));
-		if (!Left.StartsWith(Prefix)) return;
+			const FString& MountStr = Plugins[PlgIdx].MountPath;
+			if (MountStr.IsEmpty() || SkipUsed[PlgIdx]) continue;
 
-		const FString ModuleName = Left.Mid(Prefix.Len());
-		if (const FString* Plug = ModuleToPlugin.Find(ModuleName))
-			OutUsed.Add(*Plug);
+			// em lotes: o primeiro referencer de /Game encerra a enumeração do plugin
+			Source.EnumerateAssetsByPath(FName(*MountStr), BatchSize, [&](TConstArrayView<FAssetData> PlgAssets)
+				{
+					for (const FAssetData& PAD : PlgAssets)
+					{
+						++Counters.DependencyQueries;
+						TArray<FName> RefPkgs;
+						Source.GetReferencers(PAD.PackageName, RefPkgs);
+
+						for (const FName& Ref : RefPkgs)
+						{
+							if (Ref.ToString().StartsWith("/Game"))
+							{
+								MarkUsed(PlgIdx, InOutUsed, Ctx.Evidence, EPluginEvidenceKind::Referencer, Ref, PAD.PackageName);
+								return false;
+							}
+						}
+					}
+					return !Ctx.IsCancelled();
+				});
+		}
+		return !Ctx.IsCancelled();
 	}
+
+	// Grava tempo e memória da fase em Stats ao sair do escopo; no Insights a
+	// fase aparece como evento próprio e os contadores são atualizados no fim
+	struct FScopedPhase
+	{
+		FScopedPhase(FPluginScanStats& InStats, EPluginScanPhase InPhase)
+			: Stats(InStats), Phase(InPhase), Start(FPlatformTime::Seconds())
+			, StartMemory(FPlatformMemory::GetStats().UsedPhysical)
+		{
+#if CPUPROFILERTRACE_ENABLED
+			FCpuProfilerTrace::OutputBeginDynamicEvent(LexToString(Phase));
+#endif
+		}
+
+		~FScopedPhase()
+		{
+#if CPUPROFILERTRACE_ENABLED
+			FCpuProfilerTrace::OutputEndEvent();
+#endif
+			FPluginScanPhaseStats& P = Stats.Phases.AddDefaulted_GetRef();
+			P.Phase = Phase;
+			P.Seconds = FPlatformTime::Seconds() - Start;
+			P.MemoryDeltaBytes = int64(FPlatformMemory::GetStats().UsedPhysical) - int64(StartMemory);
+
+			TRACE_COUNTER_SET(PluginScan_PackagesVisited, Stats.Counters.PackagesVisited);
+			TRACE_COUNTER_SET(PluginScan_AssetsVisited, Stats.Counters.AssetsVisited);
+			TRACE_COUNTER_SET(PluginScan_TagLookups, Stats.Counters.TagLookups);
+			TRACE_COUNTER_SET(PluginScan_DependencyQueries, Stats.Counters.DependencyQueries);
+		}
+
+		FPluginScanStats& Stats;
+		EPluginScanPhase Phase;
+		double Start;
+		uint64 StartMemory;
+	};
 }
 
-void FPluginUsageScanner::Scan(FPluginScanResult& Out)
+bool PluginScan::RunScan(const TArray<FScanPlugin>& Plugins, const FPluginScanOptions& Options,
+	const IPluginScanSource& Source, FScanContext& Ctx, FPluginScanResult& Out, const FPluginBaseIndex* Base)
 {
-	// ------------------ AssetRegistry ------------------
-	FAssetRegistryModule& ARM = FModuleManager::LoadModuleChecked<FAssetRegistryModule>("AssetRegistry");
-	IAssetRegistry& AR = ARM.Get();
-	AR.WaitForCompletion();
+	LLM_SCOPE_BYNAME(TEXT("PluginOptimizer"));
+	TRACE_CPUPROFILER_EVENT_SCOPE(PluginScan_RunScan);
+
+	for (const FScanPlugin& P : Plugins) Out.EnabledPlugins.Add(P.Name);
 
-	// ------------------ plugins habilitados ------------
-	TArray<TSharedRef<IPlugin>> Plugins = IPluginManager::Get().GetEnabledPlugins();
-	for (const TSharedRef<IPlugin>& P : Plugins) Out.EnabledPlugins.Add(P->GetName());
+	FPluginBaseLayer Layer;
+	FPluginModuleResolver Resolver;
+	BuildResolver(Plugins, Base, Layer, Resolver);
 
-	// módulo -> plugin
-	TMap<FString, FString> ModuleToPlugin;
-	for (const TSharedRef<IPlugin>& P : Plugins)
+	TSharedPtr<FPluginEvidenceIndex> Evidence;
+	if (Options.MaxEvidencePerPlugin > 0)
+		Evidence = MakeShared<FPluginEvidenceIndex>(Plugins.Num(), Options.MaxEvidencePerPlugin);
+	Ctx.Evidence = Evidence.Get();
+	ON_SCOPE_EXIT{ Ctx.Evidence = nullptr; };
+
+	// um used-set por passada: o motivo de cada plugin sai da combinação
+	TBitArray<> UsedByAssets(false, Plugins.Num());
+	TBitArray<> UsedByRefs(false, Plugins.Num());
+	TBitArray<> UsedByImports(false, Plugins.Num());
+	TBitArray<> UsedBySource(false, Plugins.Num());
+	TBitArray<> UsedByConfig(false, Plugins.Num());
+	TBitArray<> UsedByModules(false, Plugins.Num());
+
+	// parada antecipada: cada alvo se confirma por ele mesmo ou por quem depende dele
 	{
-		for (const FModuleDescriptor& M : P->GetDescriptor().Modules)
-			ModuleToPlugin.Add(M.Name.ToString(), P->GetName());
+		FPluginDependencyGraph Graph;
+		Graph.Build(Plugins);
+		for (int32 Idx = 0; Idx < Plugins.Num(); ++Idx)
+		{
+			if (!Ctx.Targets.IsEmpty() && !Ctx.Targets.Contains(Plugins[Idx].Name))
+				continue;
+			TBitArray<>& Goal = Ctx.Goals.Add_GetRef(Graph.GetDependents(Idx));
+			Goal[Idx] = true;
+		}
+		Ctx.UsedSoFar.Init(false, Plugins.Num());
 	}
 
-	TSet<FString> Used;
+	// chamado entre lotes e passadas, nunca com workers rodando
+	auto GoalsMet = [&]()
+		{
+			Ctx.UsedSoFar = UsedByAssets;
+			for (const TBitArray<>* Used : { &UsedByRefs, &UsedByImports, &UsedBySource, &UsedByConfig, &UsedByModules })
+				Ctx.UsedSoFar.CombineWithBitwiseOR(*Used, EBitwiseOperatorFlags::MaintainSize);
+			if (Ctx.CheckGoals(Ctx.UsedSoFar))
+				Out.Stats.bStoppedEarly = true;
+			return Out.Stats.bStoppedEarly;
+		};
 
 	// ------------------ 1) Classes usadas em assets ----
-	TArray<FAssetData> GameAssets;
-	AR.GetAssetsByPath("/Game", GameAssets, true);
+	// /Game chega em lotes sem total conhecido: fase indeterminada
+	Ctx.Report(EPluginScanPhase::GameAssets, -1.f);
+	TOptional<FScopedPhase> Phase(InPlace, Out.Stats, EPluginScanPhase::GameAssets);
 
-	for (const FAssetData& AD : GameAssets)
-	{
-		// classe do asset (diferença 5.0 vs 5.1+)
-		FString ClassPath;
-#if ENGINE_MAJOR_VERSION == 5 && ENGINE_MINOR_VERSION < 1
-		ClassPath = AD.AssetClass.ToString();
-#else
-		ClassPath = AD.AssetClassPath.ToString();
-#endif
-		ConsiderClassPath(ClassPath, ModuleToPlugin, Used);
+	// cache por pacote: só pacotes novos ou modificados são reclassificados
+	const FString CachePath = Options.CachePath.IsEmpty() ? FPluginScanCache::GetDefaultPath() : Options.CachePath;
+	const FString ProjectDir = Options.ProjectDir.IsEmpty() ? FPaths::ProjectDir() : Options.ProjectDir;
+	const uint32 CacheSignature = ComputeCacheSignature(Plugins, Options);
 
-		auto CheckTag = [&](FName Tag)
-			{
-				FString Val;
-				if (AD.GetTagValue(Tag, Val))
-					ConsiderClassPath(Val, ModuleToPlugin, Used);
-			};
+	FPluginScanCache OldCache;
+	FPackageHits CacheHits;
+	if (Options.bUseCache)
+		OldCache.Load(CachePath, CacheSignature, Out.EnabledPlugins);
+	FPackageHits* Hits = Options.bUseCache ? &CacheHits : nullptr;
 
-		CheckTag("NativeParentClass");
-		CheckTag("ParentClass");
-		CheckTag("GeneratedClass");
+	// /Game chega em lotes: dos assets só o lote corrente fica em memória; de
+	// cada pacote sobra o nome (passada 2 e cache) e se ele é actor externo
+	TArray<FName> Packages;
+	TBitArray<> ExternalPackages;
+	TArray<int32> AssetOrder;
+	bool bPass1 = true;
 
-		FString Interfaces;
-		if (AD.GetTagValue("ImplementedInterfaces", Interfaces))
+	Source.EnumerateAssetsByPath("/Game", Options.AssetBatchSize, [&](TConstArrayView<FAssetData> GameAssets)
 		{
-			const FString Marker(TEXT("/Script/"));
-			int32 Pos = 0;
-			while ((Pos = Interfaces.Find(Marker, ESearchCase::IgnoreCase, ESearchDir::FromStart, Pos)) != INDEX_NONE)
+			const int32 FirstPkg = Packages.Num();
+			const TArray<FGamePackage> Batch = GroupByPackage(GameAssets, AssetOrder);
+			for (const FGamePackage& Pkg : Batch)
 			{
-				int32 End = Interfaces.Find(TEXT("."), ESearchCase::IgnoreCase, ESearchDir::FromStart, Pos);
-				FString Slice = (End != INDEX_NONE) ? Interfaces.Mid(Pos, End - Pos) : Interfaces.Mid(Pos);
-				ConsiderClassPath(Slice, ModuleToPlugin, Used);
-				Pos = (End == INDEX_NONE) ? Pos + Marker.Len() : End;
+				Packages.Add(Pkg.Name);
+				ExternalPackages.Add(Options.bLightweightExternalActors && IsExternalActorPackage(Pkg.Name));
 			}
+			if (Hits)
+			{
+				Hits->NewEntries.SetNum(Packages.Num());
+				Hits->Cached.SetNumZeroed(Packages.Num());
+			}
+
+			bPass1 = ParallelClassify(Batch.Num(), Plugins.Num(), EPluginScanPhase::GameAssets, Ctx, UsedByAssets,
+				[&](int32 BatchIdx, FChunkState& State)
+				{
+					const FGamePackage& Pkg = Batch[BatchIdx];
+					const int32 PkgIdx = FirstPkg + BatchIdx;
+					++State.Scratch.Counters.PackagesVisited;
+
+					// actor externo: só a classe (actors não têm tags de classe nativa)
+					if (ExternalPackages[PkgIdx])
+					{
+						for (int32 i = 0; i < Pkg.NumAssets; ++i)
+							ClassifyAssetClass(GameAssets[AssetOrder[Pkg.FirstAsset + i]], Resolver, State.Scratch, State.Used);
+						return;
+					}
+
+					if (Hits)
+					{
+						FPluginScanCacheEntry& Entry = Hits->NewEntries[PkgIdx];
+						Entry.Hash = Source.GetPackageHash(Pkg.Name);
+						Hits->Cached[PkgIdx] = OldCache.Find(Pkg.Name, Entry.Hash);
+						if (Hits->Cached[PkgIdx])
+						{
+							++State.Scratch.Counters.CachedPackages;
+							Entry.AssetHits = Hits->Cached[PkgIdx]->AssetHits;
+							MarkHits(Entry.AssetHits, Pkg.Name, State.Scratch, State.Used);
+							return;
+						}
+					}
+
+					ClassifyPackage(State, Hits ? &Hits->NewEntries[PkgIdx].AssetHits : nullptr,
+						[&](TBitArray<>& Bits)
+						{
+							for (int32 i = 0; i < Pkg.NumAssets; ++i)
+								ClassifyGameAsset(GameAssets[AssetOrder[Pkg.FirstAsset + i]], Resolver, State.Scratch, Bits);
+						});
+				}, MinItemsPerChunk, false);
+			return bPass1 && !GoalsMet();
+		});
+	if (!bPass1 || Ctx.IsCancelled()) return false;
+
+	// ------------------ 2) Assets de plugin referenciados por /Game ----
+	Ctx.Report(EPluginScanPhase::PluginReferences, 0.f);
+	Phase.Emplace(Out.Stats, EPluginScanPhase::PluginReferences);
+
+	if (!GoalsMet())
+	{
+		const bool bPass2 = (Options.ReferencePass == EPluginReferencePass::GameDependencies)
+			? ScanGameDependencies(Packages, ExternalPackages, Resolver, Plugins.Num(), Source, Ctx, Hits, UsedByRefs)
+			: ScanPluginReferencers(Plugins, Source, Options.AssetBatchSize, Ctx, UsedByAssets, UsedByRefs);
+		if (!bPass2) return false;
+	}
+
+	// ------------------ imports dos headers (opcional) ----------------
+	if (Options.bScanPackageImports)
+	{
+		Ctx.Report(EPluginScanPhase::PackageImports, 0.f);
+		Phase.Emplace(Out.Stats, EPluginScanPhase::PackageImports);
+
+		// o que já tem motivo não muda o resultado, mas o cache precisa dos hits
+		// de todos os pacotes: só a parada antecipada pula a passada. Actors
+		// externos entram mesmo no caminho leve: componentes por instância só
+		// aparecem nos imports (e, sem entrada de cache, são relidos a cada scan)
+		if (!GoalsMet() && !ScanGameImports(Packages, TBitArray<>(false, Packages.Num()), FPaths::Combine(ProjectDir, TEXT("Content")),
+			Resolver, Plugins.Num(), Ctx, Hits, UsedByImports))
+			return false;
+	}
+
+	// pacotes removidos somem do cache porque ele é refeito a partir do registry;
+	// actors externos no caminho leve ficam de fora. Parada antecipada deixa
+	// pacotes sem classificar: o cache anterior continua valendo
+	if (Hits && !Ctx.AreGoalsMet())
+	{
+		FPluginScanCache NewCache;
+		NewCache.Reserve(Packages.Num());
+		for (int32 PkgIdx = 0; PkgIdx < Packages.Num(); ++PkgIdx)
+		{
+			if (!ExternalPackages[PkgIdx])
+				NewCache.Add(Packages[PkgIdx], MoveTemp(Hits->NewEntries[PkgIdx]));
 		}
+		NewCache.Save(CachePath, CacheSignature, Out.EnabledPlugins);
 	}
 
-	// ------------------ 2) Assets de plugin referenciados por /Game ----
-	for (const TSharedRef<IPlugin>& P : Plugins)
+	// ------------------ código do projeto (Build.cs / #include) --------
+	Ctx.Report(EPluginScanPhase::ProjectSource, 0.f);
+	Phase.Emplace(Out.Stats, EPluginScanPhase::ProjectSource);
+
+	if (Options.bScanSource && !GoalsMet())
 	{
-		// 5.0-5.5: FName   |   5.6: FString
-		auto MountPath = P->GetMountedAssetPath();
-		FString MountStr = FString(MountPath);		// ctor aceita FName ou FString
-		if (MountStr.IsEmpty()) continue;
+		TBitArray<> AlreadyUsed = UsedByAssets;
+		AlreadyUsed.CombineWithBitwiseOR(UsedByRefs, EBitwiseOperatorFlags::MaintainSize);
+
+		if (!ScanProjectSource(FPaths::Combine(ProjectDir, TEXT("Source")), Plugins, Resolver, AlreadyUsed, Ctx, UsedBySource, &Layer))
+			return false;
+	}
+
+	// ------------------ .ini do projeto ---------------------------------
+	Ctx.Report(EPluginScanPhase::ProjectConfig, 0.f);
+	Phase.Emplace(Out.Stats, EPluginScanPhase::ProjectConfig);
 
-		TArray<FAssetData> PlgAssets;
-		AR.GetAssetsByPath(FName(*MountStr), PlgAssets, true);
+	if (Options.bScanConfig && !GoalsMet() && !ScanProjectConfig(FPaths::Combine(ProjectDir, TEXT("Config")), Resolver, Ctx, UsedByConfig))
+		return false;
 
-		for (const FAssetData& PAD : PlgAssets)
+	// ------------------ 3) módulos carregados no editor ---------------
+	Ctx.Report(EPluginScanPhase::LoadedModules, -1.f);
+	Phase.Emplace(Out.Stats, EPluginScanPhase::LoadedModules);
+
+	if (Options.bCheckLoadedModules && !GoalsMet())
+	{
+		// pelos plugins, não por Resolver.GetModules(): com base, ele só tem os de fora dela
+		for (int32 Idx = 0; Idx < Plugins.Num(); ++Idx)
 		{
-			TArray<FName> RefPkgs;
-			AR.GetReferencers(
-				PAD.PackageName,
-				RefPkgs,
-				UE::AssetRegistry::EDependencyCategory::Package,
-				UE::AssetRegistry::EDependencyQuery::Hard | UE::AssetRegistry::EDependencyQuery::Soft);
-
-			for (const FName& Ref : RefPkgs)
+			for (const FName M : Plugins[Idx].Modules)
 			{
-				if (Ref.ToString().StartsWith("/Game"))
-				{
-					Used.Add(P->GetName());
-					break;
-				}
+				if (FModuleManager::Get().IsModuleLoaded(M) && Resolver.FindByModuleName(M) == Idx)
+					MarkUsed(Idx, UsedByModules, Ctx.Evidence, EPluginEvidenceKind::LoadedModule, M);
 			}
-			if (Used.Contains(P->GetName())) break;
 		}
 	}
+	Phase.Reset();
 
-	// ------------------ 3) módulos carregados no editor ---------------
-	for (const TPair<FString, FString>& Pair : ModuleToPlugin)
+	Out.UsageReasons.SetNumZeroed(Plugins.Num());
+	for (int32 Idx = 0; Idx < Plugins.Num(); ++Idx)
 	{
-		if (FModuleManager::Get().IsModuleLoaded(*Pair.Key))
-			Used.Add(Pair.Value);
+		EPluginUsageReason& R = Out.UsageReasons[Idx];
+		if (UsedByAssets[Idx])  R |= EPluginUsageReason::AssetClass;
+		if (UsedByRefs[Idx])    R |= EPluginUsageReason::Referenced;
+		if (UsedByImports[Idx]) R |= EPluginUsageReason::PackageImport;
+		if (UsedBySource[Idx])  R |= EPluginUsageReason::SourceCode;
+		if (UsedByConfig[Idx])  R |= EPluginUsageReason::Config;
+		if (UsedByModules[Idx]) R |= EPluginUsageReason::LoadedModule;
 	}
 
-	Used.Sort([](const FString& A, const FString& B) { return A < B; });
-	Out.UsedPlugins = Used.Array();
+	FinalizeResult(Plugins, Out, Evidence.Get(), Options.TargetPlatform);
+	Out.Evidence = Evidence;
+	Out.Stats.PeakUsedPhysicalBytes = FPlatformMemory::GetStats().PeakUsedPhysical;
+
+	Ctx.Report(EPluginScanPhase::Done, 1.f);
+	return true;
+}
+
+
+const TCHAR* LexToString(EPluginScanPhase Phase)
+{
+	switch (Phase)
+	{
+	case EPluginScanPhase::WaitingForRegistry: return TEXT("WaitingForRegistry");
+	case EPluginScanPhase::GameAssets:         return TEXT("GameAssets");
+	case EPluginScanPhase::PluginReferences:   return TEXT("PluginReferences");
+	case EPluginScanPhase::PackageImports:     return TEXT("PackageImports");
+	case EPluginScanPhase::ProjectSource:      return TEXT("ProjectSource");
+	case EPluginScanPhase::ProjectConfig:      return TEXT("ProjectConfig");
+	case EPluginScanPhase::LoadedModules:      return TEXT("LoadedModules");
+	default:                                   return TEXT("Done");
+	}
+}
+
+FString LexToString(EPluginUsageReason Reasons)
+{
+	TArray<FString> Parts;
+	if (EnumHasAnyFlags(Reasons, EPluginUsageReason::AssetClass))   Parts.Add(TEXT("AssetClass"));
+	if (EnumHasAnyFlags(Reasons, EPluginUsageReason::Referenced))   Parts.Add(TEXT("Referenced"));
+	if (EnumHasAnyFlags(Reasons, EPluginUsageReason::LoadedModule)) Parts.Add(TEXT("LoadedModule"));
+	if (EnumHasAnyFlags(Reasons, EPluginUsageReason::Dependency))   Parts.Add(TEXT("Dependency"));
+	if (EnumHasAnyFlags(Reasons, EPluginUsageReason::SourceCode))   Parts.Add(TEXT("SourceCode"));
+	if (EnumHasAnyFlags(Reasons, EPluginUsageReason::Config))       Parts.Add(TEXT("Config"));
+	if (EnumHasAnyFlags(Reasons, EPluginUsageReason::PackageImport)) Parts.Add(TEXT("PackageImport"));
+	return FString::Join(Parts, TEXT("|"));
+}
+
+const TCHAR* LexToString(EPluginBuildTarget Target)
+{
+	switch (Target)
+	{
+	case EPluginBuildTarget::Game:   return TEXT("Game");
+	case EPluginBuildTarget::Client: return TEXT("Client");
+	case EPluginBuildTarget::Server: return TEXT("Server");
+	default:                         return TEXT("Unknown");
+	}
+}
+
+FPluginScanCounters& FPluginScanCounters::operator+=(const FPluginScanCounters& Other)
+{
+	PackagesVisited   += Other.PackagesVisited;
+	AssetsVisited     += Other.AssetsVisited;
+	TagLookups        += Other.TagLookups;
+	DependencyQueries += Other.DependencyQueries;
+	CachedPackages    += Other.CachedPackages;
+	SourceFiles       += Other.SourceFiles;
+	ConfigFiles       += Other.ConfigFiles;
+	PackageHeaders    += Other.PackageHeaders;
+	return *this;
+}
+
+double FPluginScanStats::GetTotalSeconds() const
+{
+	double Total = 0.0;
+	for (const FPluginScanPhaseStats& P : Phases)
+		Total += P.Seconds;
+	return Total;
+}
+
+FString FPluginScanStats::ToString() const
+{
+	TStringBuilder<1024> Out;
+	for (const FPluginScanPhaseStats& P : Phases)
+	{
+		Out.Appendf(TEXT("%-20s %8.1f ms %+9.1f MB\n"), LexToString(P.Phase),
+			P.Seconds * 1000.0, double(P.MemoryDeltaBytes) / (1024.0 * 1024.0));
+	}
+	Out.Appendf(TEXT("%-20s %8.1f ms\n\n"), TEXT("Total"), GetTotalSeconds() * 1000.0);
+
+	Out.Appendf(TEXT("Packages visited:    %lld (%lld from cache)\n"), Counters.PackagesVisited, Counters.CachedPackages);
+	Out.Appendf(TEXT("Assets visited:      %lld\n"), Counters.AssetsVisited);
+	Out.Appendf(TEXT("Tag lookups:         %lld\n"), Counters.TagLookups);
+	Out.Appendf(TEXT("Dependency queries:  %lld\n"), Counters.DependencyQueries);
+	Out.Appendf(TEXT("Source / ini files:  %lld / %lld\n"), Counters.SourceFiles, Counters.ConfigFiles);
+	Out.Appendf(TEXT("Package headers:     %lld\n"), Counters.PackageHeaders);
+	Out.Appendf(TEXT("Peak memory:         %.1f MB"), double(PeakUsedPhysicalBytes) / (1024.0 * 1024.0));
+	if (bStoppedEarly)
+		Out.Append(TEXT("\nStopped early:       all targets confirmed"));
+	return FString(Out.ToView());
+}
+
+FText FPluginScanProgress::GetPhaseText() const
+{
+	switch (Phase)
+	{
+	case EPluginScanPhase::WaitingForRegistry: return LOCTEXT("PhaseRegistry", "Waiting for Asset Registry...");
+	case EPluginScanPhase::GameAssets:         return LOCTEXT("PhaseAssets", "Scanning /Game asset classes...");
+	case EPluginScanPhase::PluginReferences:   return LOCTEXT("PhaseRefs", "Checking plugin content references...");
+	case EPluginScanPhase::PackageImports:     return LOCTEXT("PhaseImports", "Reading package import tables...");
+	case EPluginScanPhase::ProjectSource:      return LOCTEXT("PhaseSource", "Scanning project source...");
+	case EPluginScanPhase::ProjectConfig:      return LOCTEXT("PhaseConfig", "Scanning project config...");
+	case EPluginScanPhase::LoadedModules:      return LOCTEXT("PhaseModules", "Checking loaded modules...");
+	default:                                   return LOCTEXT("PhaseDone", "Done");
+	}
+}
+
+void FPluginUsageScanner::Scan(FPluginScanResult& Out, const FPluginScanOptions& Options)
+{
+	// ------------------ AssetRegistry ------------------
+	IAssetRegistry& AR = GetAssetRegistry();
+	{
+		FScopedPhase Phase(Out.Stats, EPluginScanPhase::WaitingForRegistry);
+		AR.WaitForCompletion();
+	}
+	const FAssetRegistryScanSource Source(AR);
+
+	FScanContext Ctx;
+	Ctx.Counters = &Out.Stats.Counters;
+	RunScan(GatherEnabledPlugins(), Options, Source, Ctx, Out);
+}
+
+void FPluginUsageScanner::QueryPlugins(const TArray<FString>& PluginNames, FPluginScanResult& Out,
+	const FPluginScanOptions& Options)
+{
+	TArray<FScanPlugin> Enabled = GatherEnabledPlugins();
+
+	// alvos + quem depende deles (uso de um dependente confirma o alvo)
+	FPluginDependencyGraph Graph;
+	Graph.Build(Enabled);
+	TBitArray<> Keep(false, Enabled.Num());
+	for (int32 Idx = 0; Idx < Enabled.Num(); ++Idx)
+	{
+		if (PluginNames.Contains(Enabled[Idx].Name))
+		{
+			Keep[Idx] = true;
+			Keep.CombineWithBitwiseOR(Graph.GetDependents(Idx), EBitwiseOperatorFlags::MaintainSize);
+		}
+	}
+
+	TArray<FScanPlugin> Plugins;
+	for (TConstSetBitIterator<> It(Keep); It; ++It)
+		Plugins.Add(MoveTemp(Enabled[It.GetIndex()]));
+	if (Plugins.IsEmpty())
+		return;
+
+	IAssetRegistry& AR = GetAssetRegistry();
+	{
+		FScopedPhase Phase(Out.Stats, EPluginScanPhase::WaitingForRegistry);
+		AR.WaitForCompletion();
+	}
+	const FAssetRegistryScanSource Source(AR);
+
+	// a assinatura do subconjunto não bate com a do scan completo: sem cache
+	FPluginScanOptions QueryOptions = Options;
+	QueryOptions.bUseCache = false;
+
+	FScanContext Ctx;
+	Ctx.Counters = &Out.Stats.Counters;
+	Ctx.Targets = PluginNames;
+	RunScan(Plugins, QueryOptions, Source, Ctx, Out);
+}
+
+bool PluginScan::RunRegistryFileScan(const TArray<FScanPlugin>& Plugins, const FString& RegistryPath,
+	const FPluginScanOptions& Options, FPluginScanResult& Out, const FPluginBaseIndex* Base)
+{
+	LLM_SCOPE_BYNAME(TEXT("PluginOptimizer"));
+
+	// a "espera pelo registry" aqui é a desserialização do arquivo
+	FRegistryFileScanSource Source;
+	{
+		FScopedPhase Phase(Out.Stats, EPluginScanPhase::WaitingForRegistry);
+		if (!Source.Load(RegistryPath))
+			return false;
+	}
+
+	FPluginScanOptions FileOptions = Options;
+	FileOptions.bCheckLoadedModules = false;
+
+	FScanContext Ctx;
+	Ctx.Counters = &Out.Stats.Counters;
+	return RunScan(Plugins, FileOptions, Source, Ctx, Out, Base);
+}
+
+bool FPluginUsageScanner::ScanRegistryFile(const FString& RegistryPath, FPluginScanResult& Out,
+	const FPluginScanOptions& Options)
+{
+	return RunRegistryFileScan(GatherEnabledPlugins(), RegistryPath, Options, Out);
+}
+
+bool FPluginUsageScanner::ScanMapReachability(FPluginMapReachability& Out, const FString& RegistryPath,
+	const FPluginScanOptions& Options)
+{
+	const TArray<FScanPlugin> Plugins = GatherEnabledPlugins();
+	if (!RegistryPath.IsEmpty())
+	{
+		FRegistryFileScanSource Source;
+		if (!Source.Load(RegistryPath))
+			return false;
+		RunMapReachability(Plugins, Options, Source, Out);
+		return true;
+	}
+
+	IAssetRegistry& AR = GetAssetRegistry();
+	AR.WaitForCompletion();
+	RunMapReachability(Plugins, Options, FAssetRegistryScanSource(AR), Out);
+	return true;
+}
+
+TSharedRef<FPluginScanTask> FPluginUsageScanner::ScanAsync(FOnPluginScanProgress OnProgress,
+	FOnPluginScanComplete OnComplete, const FPluginScanOptions& Options)
+{
+	check(IsInGameThread());
+
+	TSharedRef<FPluginScanTask> Task = MakeShared<FPluginScanTask>();
+	IAssetRegistry& AR = GetAssetRegistry();
+	TArray<FScanPlugin> Plugins = GatherEnabledPlugins();
+
+	Async(EAsyncExecution::ThreadPool,
+		[Task, &AR, Plugins = MoveTemp(Plugins), Options, OnProgress, OnComplete]()
+		{
+			const FAssetRegistryScanSource Source(AR);
+			FScanContext Ctx;
+			Ctx.Task = &Task.Get();
+
+			// só manda pro game thread quando muda de fase ou avança >= 1%
+			FPluginScanProgress LastSent;
+			LastSent.Phase = EPluginScanPhase::Done;
+			Ctx.OnProgress = [Task, OnProgress, LastSent](const FPluginScanProgress& P) mutable
+				{
+					if (P.Phase == LastSent.Phase && P.Fraction - LastSent.Fraction < 0.01f)
+						return;
+					LastSent = P;
+
+					AsyncTask(ENamedThreads::GameThread, [Task, OnProgress, P]()
+						{
+							if (!Task->IsCancelled())
+								OnProgress.ExecuteIfBound(P);
+						});
+				};
+
+			FPluginScanResult Result;
+			Ctx.Counters = &Result.Stats.Counters;
+
+			// ------------------ espera o AssetRegistry sem travar o editor ----
+			Ctx.Report(EPluginScanPhase::WaitingForRegistry, -1.f);
+			{
+				FScopedPhase Phase(Result.Stats, EPluginScanPhase::WaitingForRegistry);
+				while (Source.IsLoading() && !Ctx.IsCancelled())
+					FPlatformProcess::Sleep(0.1f);
+			}
+			const bool bCompleted = !Ctx.IsCancelled() && RunScan(Plugins, Options, Source, Ctx, Result);
+
+			// só o resultado final volta pro game thread
+			AsyncTask(ENamedThreads::GameThread,
+				[Task, OnComplete, bCompleted, Result = MoveTemp(Result)]()
+				{
+					Task->bFinished = true;
+					if (bCompleted && !Task->IsCancelled())
+						OnComplete.ExecuteIfBound(Result);
+				});
+		});
+
+	return Task;
 }
+
+#undef LOCTEXT_NAMESPACE
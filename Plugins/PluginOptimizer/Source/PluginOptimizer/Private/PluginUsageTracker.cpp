@@ -0,0 +1,303 @@
+#include "PluginUsageTracker.h"
+#include "PluginUsageScanner.h"
+#include "PluginScanSource.h"
+#include "PluginSourceScanner.h"
+#include "PluginConfigScanner.h"
+
+#include "AssetRegistry/IAssetRegistry.h"
+#include "AssetRegistry/AssetData.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Modules/ModuleManager.h"
+#include "Async/Async.h"
+#include "HAL/PlatformProcess.h"
+#include "HAL/LowLevelMemTracker.h"
+
+using namespace PluginScan;
+
+namespace
+{
+	bool IsGamePackage(FName PackageName)
+	{
+		return WriteToString<256>(PackageName).ToView().StartsWith(TEXT("/Game/"));
+	}
+
+	// Mesmo critério da passada 1 do scan: actor externo (com a opção padrão) só pela classe
+	void ClassifyTrackedAsset(const FAssetData& AD, bool bExternalActor, const FPluginModuleResolver& Resolver,
+		FClassifyScratch& Scratch, TBitArray<>& OutUsed)
+	{
+		if (bExternalActor)
+			ClassifyAssetClass(AD, Resolver, Scratch, OutUsed);
+		else
+			ClassifyGameAsset(AD, Resolver, Scratch, OutUsed);
+	}
+
+	bool IsLightweightPackage(FName PackageName)
+	{
+		static const bool bLightweight = FPluginScanOptions().bLightweightExternalActors;
+		return bLightweight && IsExternalActorPackage(PackageName);
+	}
+}
+
+FPluginUsageTracker::~FPluginUsageTracker()
+{
+	Stop();
+}
+
+void FPluginUsageTracker::Start()
+{
+	check(IsInGameThread());
+	if (bRunning) return;
+
+	bRunning = true;
+	bReady = false;
+	++Generation;
+
+	Plugins = GatherEnabledPlugins();
+	Resolver = FPluginModuleResolver();
+	BuildResolver(Plugins, Resolver);
+
+	PackageHits.Reset();
+	RefCounts.Init(0, Plugins.Num());
+	DirtyPackages.Reset();
+	UsedBySource.Init(false, Plugins.Num());
+	UsedByConfig.Init(false, Plugins.Num());
+
+	IAssetRegistry& AR = GetAssetRegistry();
+	AR.OnAssetAdded().AddRaw(this, &FPluginUsageTracker::OnAssetAdded);
+	AR.OnAssetRemoved().AddRaw(this, &FPluginUsageTracker::OnAssetRemoved);
+	AR.OnAssetRenamed().AddRaw(this, &FPluginUsageTracker::OnAssetRenamed);
+	AR.OnAssetUpdated().AddRaw(this, &FPluginUsageTracker::OnAssetUpdated);
+
+	TickHandle = FTSTicker::GetCoreTicker().AddTicker(
+		FTickerDelegate::CreateRaw(this, &FPluginUsageTracker::ProcessDirty));
+
+	// ------------------ contagem inicial em background ----------------
+	SeedSnapshotTaken = MakeShared<std::atomic<bool>>(false);
+
+	TWeakPtr<FPluginUsageTracker> WeakThis = AsShared();
+	const uint32 SeedGeneration = Generation;
+
+	Async(EAsyncExecution::ThreadPool,
+		[WeakThis, SeedGeneration, &AR, SnapshotTaken = SeedSnapshotTaken, SeedPlugins = Plugins, SeedResolver = Resolver,
+			ProjectDir = FPaths::ProjectDir()]()
+		{
+			const int32 NumPlugins = SeedPlugins.Num();
+			LLM_SCOPE_BYNAME(TEXT("PluginOptimizer"));
+			const FAssetRegistryScanSource Source(AR);
+
+			while (AR.IsLoadingAssets())
+			{
+				if (!WeakThis.IsValid()) return;
+				FPlatformProcess::Sleep(0.1f);
+			}
+
+			// antes da consulta: um evento que chega durante ela marca o pacote e o
+			// refresh depois do seed só repete a classificação (idempotente)
+			*SnapshotTaken = true;
+
+			TRACE_CPUPROFILER_EVENT_SCOPE(PluginScan_TrackerSeed);
+
+			// em lotes, como a passada 1: só o lote corrente de FAssetData fica em memória
+			TArray<FName> Names;
+			TArray<TArray<int32>> Hits;
+			TArray<int32> AssetOrder;
+			TBitArray<> ContentUsed(false, NumPlugins);
+			Source.EnumerateAssetsByPath("/Game", FPluginScanOptions().AssetBatchSize, [&](TConstArrayView<FAssetData> GameAssets)
+				{
+					const int32 FirstPkg = Names.Num();
+					const TArray<FGamePackage> Batch = GroupByPackage(GameAssets, AssetOrder);
+					for (const FGamePackage& Pkg : Batch) Names.Add(Pkg.Name);
+					Hits.SetNum(Names.Num());
+
+					ParallelClassify(Batch.Num(), NumPlugins, EPluginScanPhase::GameAssets, FScanContext(), ContentUsed,
+						[&](int32 BatchIdx, FChunkState& State)
+						{
+							const FGamePackage& Pkg = Batch[BatchIdx];
+							const bool bLightweight = IsLightweightPackage(Pkg.Name);
+							ClassifyPackage(State, &Hits[FirstPkg + BatchIdx], [&](TBitArray<>& PkgBits)
+								{
+									for (int32 i = 0; i < Pkg.NumAssets; ++i)
+										ClassifyTrackedAsset(GameAssets[AssetOrder[Pkg.FirstAsset + i]], bLightweight, SeedResolver, State.Scratch, PkgBits);
+									ClassifyPackageDependencies(Source, Pkg.Name, SeedResolver, State.Scratch, PkgBits);
+								});
+						}, MinItemsPerChunk, false);
+					return WeakThis.IsValid();
+				});
+
+			// Build.cs e #include não geram eventos do registry: entram só no seed.
+			// Sem SkipUsed, para o motivo não sumir se o uso por conteúdo sumir
+			TBitArray<> SourceUsed(false, NumPlugins);
+			ScanProjectSource(FPaths::Combine(ProjectDir, TEXT("Source")), SeedPlugins, SeedResolver,
+				TBitArray<>(false, NumPlugins), FScanContext(), SourceUsed);
+
+			TBitArray<> ConfigUsed(false, NumPlugins);
+			ScanProjectConfig(FPaths::Combine(ProjectDir, TEXT("Config")), SeedResolver, FScanContext(), ConfigUsed);
+
+			AsyncTask(ENamedThreads::GameThread,
+				[WeakThis, SeedGeneration, Names = MoveTemp(Names), Hits = MoveTemp(Hits),
+					SourceUsed = MoveTemp(SourceUsed), ConfigUsed = MoveTemp(ConfigUsed)]() mutable
+				{
+					TSharedPtr<FPluginUsageTracker> This = WeakThis.Pin();
+					if (This && This->bRunning && This->Generation == SeedGeneration)
+						This->OnSeedComplete(MoveTemp(Names), MoveTemp(Hits), MoveTemp(SourceUsed), MoveTemp(ConfigUsed));
+				});
+		});
+}
+
+void FPluginUsageTracker::Stop()
+{
+	if (!bRunning) return;
+
+	bRunning = false;
+	bReady = false;
+
+	FTSTicker::GetCoreTicker().RemoveTicker(TickHandle);
+	TickHandle.Reset();
+
+	if (IAssetRegistry* AR = IAssetRegistry::Get())
+	{
+		AR->OnAssetAdded().RemoveAll(this);
+		AR->OnAssetRemoved().RemoveAll(this);
+		AR->OnAssetRenamed().RemoveAll(this);
+		AR->OnAssetUpdated().RemoveAll(this);
+	}
+
+	PackageHits.Reset();
+	DirtyPackages.Reset();
+}
+
+void FPluginUsageTracker::OnSeedComplete(TArray<FName>&& PackageNames, TArray<TArray<int32>>&& Hits,
+	TBitArray<>&& SourceUsed, TBitArray<>&& ConfigUsed)
+{
+	UsedBySource = MoveTemp(SourceUsed);
+	UsedByConfig = MoveTemp(ConfigUsed);
+
+	PackageHits.Reserve(PackageNames.Num());
+	for (int32 Idx = 0; Idx < PackageNames.Num(); ++Idx)
+		SetPackageHits(PackageNames[Idx], MoveTemp(Hits[Idx]));
+
+	bReady = true;
+
+	// o que mudou durante a contagem inicial é processado no próximo tick
+	UsageChangedEvent.Broadcast();
+}
+
+/* ---------------- eventos do AssetRegistry ---------------- */
+void FPluginUsageTracker::OnAssetAdded(const FAssetData& AD)     { MarkDirty(AD.PackageName); }
+void FPluginUsageTracker::OnAssetRemoved(const FAssetData& AD)   { MarkDirty(AD.PackageName); }
+void FPluginUsageTracker::OnAssetUpdated(const FAssetData& AD)   { MarkDirty(AD.PackageName); }
+
+void FPluginUsageTracker::OnAssetRenamed(const FAssetData& AD, const FString& OldObjectPath)
+{
+	MarkDirty(AD.PackageName);
+	MarkDirty(FName(*FPackageName::ObjectPathToPackageName(OldObjectPath)));
+}
+
+void FPluginUsageTracker::MarkDirty(FName PackageName)
+{
+	// antes do snapshot da contagem inicial o evento já vai estar refletido nela
+	if (!bReady && !(SeedSnapshotTaken && *SeedSnapshotTaken))
+		return;
+
+	if (IsGamePackage(PackageName))
+		DirtyPackages.Add(PackageName);
+}
+
+bool FPluginUsageTracker::ProcessDirty(float /*DeltaTime*/)
+{
+	if (!bReady || DirtyPackages.IsEmpty())
+		return true;
+
+	bool bChanged = false;
+	for (const FName PackageName : DirtyPackages)
+		bChanged |= RefreshPackage(PackageName);
+	DirtyPackages.Reset();
+
+	if (bChanged)
+		UsageChangedEvent.Broadcast();
+	return true;
+}
+
+/* ---------------- contagens ---------------- */
+bool FPluginUsageTracker::RefreshPackage(FName PackageName)
+{
+	IAssetRegistry& AR = GetAssetRegistry();
+
+	// game thread: pode incluir assets só em memória (ainda não salvos)
+	TArray<FAssetData> Assets;
+	AR.GetAssetsByPackageName(PackageName, Assets, false);
+
+	TArray<int32> NewHits;
+	if (!Assets.IsEmpty())
+	{
+		Bits.Init(false, Plugins.Num());
+		const bool bLightweight = IsLightweightPackage(PackageName);
+		for (const FAssetData& AD : Assets)
+			ClassifyTrackedAsset(AD, bLightweight, Resolver, Scratch, Bits);
+		ClassifyPackageDependencies(FAssetRegistryScanSource(AR), PackageName, Resolver, Scratch, Bits);
+
+		for (TConstSetBitIterator<> It(Bits); It; ++It)
+			NewHits.Add(It.GetIndex());
+	}
+
+	return SetPackageHits(PackageName, MoveTemp(NewHits));
+}
+
+bool FPluginUsageTracker::SetPackageHits(FName PackageName, TArray<int32>&& NewHits)
+{
+	bool bChanged = false;
+
+	if (TArray<int32>* Old = PackageHits.Find(PackageName))
+	{
+		for (const int32 Idx : *Old)
+			bChanged |= (--RefCounts[Idx] == 0);
+	}
+
+	for (const int32 Idx : NewHits)
+		bChanged |= (RefCounts[Idx]++ == 0);
+
+	if (NewHits.IsEmpty())
+		PackageHits.Remove(PackageName);
+	else
+		PackageHits.Add(PackageName, MoveTemp(NewHits));
+
+	return bChanged;
+}
+
+void FPluginUsageTracker::GetResult(FPluginScanResult& Out) const
+{
+	// os hits por pacote não separam classe de dependência
+	const EPluginUsageReason ContentReason = EPluginUsageReason::AssetClass | EPluginUsageReason::Referenced;
+
+	Out.UsageReasons.SetNumZeroed(Plugins.Num());
+	for (int32 Idx = 0; Idx < Plugins.Num(); ++Idx)
+	{
+		if (RefCounts[Idx] > 0)
+			Out.UsageReasons[Idx] |= ContentReason;
+	}
+
+	// código e .ini do projeto (lidos no seed)
+	for (TConstSetBitIterator<> It(UsedBySource); It; ++It)
+		Out.UsageReasons[It.GetIndex()] |= EPluginUsageReason::SourceCode;
+	for (TConstSetBitIterator<> It(UsedByConfig); It; ++It)
+		Out.UsageReasons[It.GetIndex()] |= EPluginUsageReason::Config;
+
+	// módulos carregados no editor
+	for (const TPair<FName, int32>& Pair : Resolver.GetModules())
+	{
+		if (FModuleManager::Get().IsModuleLoaded(Pair.Key))
+			Out.UsageReasons[Pair.Value] |= EPluginUsageReason::LoadedModule;
+	}
+
+	for (const FScanPlugin& P : Plugins)
+		Out.EnabledPlugins.Add(P.Name);
+
+	FinalizeResult(Plugins, Out);
+}
+
+int32 FPluginUsageTracker::GetReferenceCount(const FString& PluginName) const
+{
+	const int32 Idx = Plugins.IndexOfByPredicate([&](const FScanPlugin& P) { return P.Name == PluginName; });
+	return Idx != INDEX_NONE ? RefCounts[Idx] : 0;
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Containers/Ticker.h"
+#include "PluginScanCommon.h"
+
+#include <atomic>
+
+struct FAssetData;
+struct FPluginScanResult;
+
+/*
+ * Rastreamento contínuo do uso de plugins. Mantém, para cada pacote de /Game,
+ * os plugins que ele usa e uma contagem de referências por plugin; os eventos
+ * do AssetRegistry só reclassificam os pacotes afetados (no próximo tick).
+ * O Source/ e o Config/ do projeto são lidos uma vez, na contagem inicial.
+ */
+class FPluginUsageTracker : public TSharedFromThis<FPluginUsageTracker>
+{
+public:
+	~FPluginUsageTracker();
+
+	// Assina os eventos do AssetRegistry e faz a contagem inicial em background
+	void Start();
+	void Stop();
+
+	bool IsRunning() const { return bRunning; }
+
+	// true depois que a contagem inicial terminou
+	bool IsReady() const { return bReady; }
+
+	// Enabled/Used atuais (só faz sentido com IsReady)
+	void GetResult(FPluginScanResult& Out) const;
+
+	// Quantos pacotes de /Game usam o plugin
+	int32 GetReferenceCount(const FString& PluginName) const;
+
+	DECLARE_EVENT(FPluginUsageTracker, FOnUsageChanged);
+	FOnUsageChanged& OnUsageChanged() { return UsageChangedEvent; }
+
+private:
+	void OnAssetAdded(const FAssetData& AD);
+	void OnAssetRemoved(const FAssetData& AD);
+	void OnAssetRenamed(const FAssetData& AD, const FString& OldObjectPath);
+	void OnAssetUpdated(const FAssetData& AD);
+
+	void MarkDirty(FName PackageName);
+	bool ProcessDirty(float DeltaTime);
+	void OnSeedComplete(TArray<FName>&& PackageNames, TArray<TArray<int32>>&& Hits,
+		TBitArray<>&& SourceUsed, TBitArray<>&& ConfigUsed);
+
+	// Troca os hits do pacote; retorna true se algum plugin mudou de usado/não usado
+	bool SetPackageHits(FName PackageName, TArray<int32>&& NewHits);
+	bool RefreshPackage(FName PackageName);
+
+	TArray<PluginScan::FScanPlugin> Plugins;
+	FPluginModuleResolver           Resolver;
+
+	TMap<FName, TArray<int32>> PackageHits;
+	TArray<int32>              RefCounts;       // por índice de plugin
+	TBitArray<>                UsedBySource;    // Build.cs / #include, do seed (até o próximo Start)
+	TBitArray<>                UsedByConfig;    // "/Script/Module" nos .ini, idem
+
+	TSet<FName>                DirtyPackages;
+	FTSTicker::FDelegateHandle TickHandle;
+
+	PluginScan::FClassifyScratch Scratch;
+	TBitArray<>                  Bits;
+
+	bool bRunning = false;
+	bool bReady = false;
+	uint32 Generation = 0;                      // descarta seeds de um Start anterior
+	TSharedPtr<std::atomic<bool>> SeedSnapshotTaken;
+
+	FOnUsageChanged UsageChangedEvent;
+};
@@ -1,13 +1,19 @@
 #include "SPluginOptimizerDialog.h"
+#include "PluginUsageScanner.h"
+#include "PluginDisableBatch.h"
+#include "PluginScanSnapshot.h"
+#include "PluginTrialUnload.h"
 
-#include "Interfaces/IProjectManager.h"
 #include "Misc/ConfigCacheIni.h"
 
 #include "Widgets/Text/STextBlock.h"
 #include "Widgets/Views/SListView.h"
 #include "Widgets/Input/SButton.h"
 #include "Widgets/Input/SCheckBox.h"
+#include "Widgets/Notifications/SProgressBar.h"
 #include "Widgets/SBoxPanel.h"
+#include "Widgets/Layout/SExpandableArea.h"
+#include "Styling/CoreStyle.h"
 #include "Framework/Application/SlateApplication.h"
 #include "Misc/MessageDialog.h"
 
@@ -20,6 +26,9 @@ static const TCHAR* CFG_SECTION = TEXT("PluginOptimizer");
 static const TCHAR* CFG_KEY = TEXT("SuppressRestartPopup");
 static bool bSuppressRestartPopup = false;
 
+/* evidncias por plugin no tooltip da lista de usados */
+static constexpr int32 MaxEvidenceInTip = 5;
+
 /* ------------------------------------------------------------------ */
 /*  CONSTRUTOR                                                         */
 /* ------------------------------------------------------------------ */
@@ -34,6 +43,10 @@ void SPluginOptimizerDialog::Construct(const FArguments& InArgs)
 
 	EnabledCnt = InArgs._EnabledCount;
 	UsedCnt = InArgs._UsedCount;
+	bScanning = InArgs._IsScanning;
+	OnCancelScan = InArgs._OnCancelScan;
+	bLiveTracking = InArgs._LiveTracking;
+	OnLiveTrackingChanged = InArgs._OnLiveTrackingChanged;
 
 	for (const FString& Name : InArgs._Candidates)
 		Items.Add(MakeShared<FString>(Name));
@@ -53,11 +66,60 @@ void SPluginOptimizerDialog::Construct(const FArguments& InArgs)
 							SAssignNew(HeaderText, STextBlock).AutoWrapText(true)
 						]
 
+						/* live tracking (AssetRegistry) */
+						+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(4, 0)
+						[
+							SNew(SCheckBox)
+								.IsChecked_Lambda([this]() { return bLiveTracking ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; })
+								.OnCheckStateChanged_Lambda([this](ECheckBoxState State)
+									{
+										bLiveTracking = (State == ECheckBoxState::Checked);
+										OnLiveTrackingChanged.ExecuteIfBound(bLiveTracking);
+									})
+								.ToolTipText(LOCTEXT("LiveTrackingTip", "Keep the list up to date as assets are added, removed or saved."))
+								[
+									SNew(STextBlock).Text(LOCTEXT("LiveTracking", "Live"))
+								]
+						]
+
+						/* alterna entre candidatos e usados (com o porqu) */
+						+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(4, 0)
+						[
+							SNew(SCheckBox)
+								.IsChecked_Lambda([this]() { return bShowUsed ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; })
+								.OnCheckStateChanged_Lambda([this](ECheckBoxState State) { SetShowUsed(State == ECheckBoxState::Checked); })
+								.IsEnabled_Lambda([this]() { return !bScanning; })
+								.ToolTipText(LOCTEXT("ShowUsedTip", "List the plugins considered used; hover one to see why."))
+								[
+									SNew(STextBlock).Text(LOCTEXT("ShowUsed", "Show used"))
+								]
+						]
+
+						/* ordenao: nome / ms / MB medidos no startup */
+						+ SHorizontalBox::Slot().AutoWidth().Padding(4, 0)
+						[
+							SNew(SButton)
+								.Text_Lambda([this]()
+									{
+										switch (SortMode)
+										{
+										case ECandidateSort::StartupTime:   return LOCTEXT("SortTime", "Sort: Startup ms");
+										case ECandidateSort::StartupMemory: return LOCTEXT("SortMemory", "Sort: Startup MB");
+										case ECandidateSort::DiskSize:      return LOCTEXT("SortDisk", "Sort: Disk size");
+										default:                            return LOCTEXT("SortName", "Sort: Name");
+										}
+									})
+								.ToolTipText(LOCTEXT("SortTip", "Approximate startup cost measured in the last editor session, or size on disk, including the plugins disabled along with each candidate."))
+								.IsEnabled_Lambda([this]() { return !bShowUsed && (StartupCosts.Num() > 0 || DiskSizes.Num() > 0); })
+								.OnClicked(this, &SPluginOptimizerDialog::OnSortClicked)
+						]
+
 						/* boto Select (toggle) */
 						+ SHorizontalBox::Slot().AutoWidth().Padding(4, 0)
 						[
 							SNew(SButton)
 								.Text(LOCTEXT("Select", "Select"))
+								.IsEnabled_Lambda([this]() { return !bScanning && !bShowUsed; })
 								.OnClicked(this, &SPluginOptimizerDialog::OnSelectClicked)
 						]
 
@@ -70,6 +132,16 @@ void SPluginOptimizerDialog::Construct(const FArguments& InArgs)
 								.OnClicked(this, &SPluginOptimizerDialog::OnDisableSelectedClicked)
 						]
 
+						/* boto Trial (visvel s em select-mode) */
+						+ SHorizontalBox::Slot().AutoWidth().Padding(4, 0)
+						[
+							SAssignNew(TrialSelectedBtn, SButton)
+								.Text(LOCTEXT("TrialTop", "Trial"))
+								.ToolTipText(LOCTEXT("TrialTip", "Unload the selected plugins in this session, measure the memory reclaimed and check the /Game packages that depend on them, then restore or disable."))
+								.Visibility(EVisibility::Collapsed)
+								.OnClicked(this, &SPluginOptimizerDialog::OnTrialSelectedClicked)
+						]
+
 						/* boto Select All / Deselect All */
 						+ SHorizontalBox::Slot().AutoWidth().Padding(4, 0)
 						[
@@ -85,6 +157,55 @@ void SPluginOptimizerDialog::Construct(const FArguments& InArgs)
 						]
 				]
 
+				/* ---------------- mudanas desde o ltimo scan */
+				+ SVerticalBox::Slot().AutoHeight().Padding(6, 0, 6, 4)
+				[
+					SNew(STextBlock)
+						.Visibility_Lambda([this]() { return DiffText.IsEmpty() || bScanning ? EVisibility::Collapsed : EVisibility::Visible; })
+						.Text_Lambda([this]() { return DiffText; })
+						.ToolTipText_Lambda([this]() { return DiffTip; })
+						.ColorAndOpacity(FSlateColor::UseSubduedForeground())
+				]
+
+				/* ---------------- progresso do scan -------- */
+				+ SVerticalBox::Slot().AutoHeight().Padding(6, 0)
+				[
+					SNew(SHorizontalBox)
+						.Visibility_Lambda([this]() { return bScanning ? EVisibility::Visible : EVisibility::Collapsed; })
+
+						+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(0, 0, 6, 0)
+						[
+							SNew(STextBlock).Text_Lambda([this]() { return ScanPhaseText; })
+						]
+
+						+ SHorizontalBox::Slot().FillWidth(1).VAlign(VAlign_Center)
+						[
+							SNew(SProgressBar).Percent_Lambda([this]() { return ScanFraction; })
+						]
+
+						+ SHorizontalBox::Slot().AutoWidth().Padding(4, 0)
+						[
+							SNew(SButton)
+								.Text(LOCTEXT("CancelScan", "Cancel"))
+								.OnClicked(this, &SPluginOptimizerDialog::OnCancelScanClicked)
+						]
+				]
+
+				/* ---------------- estatsticas do scan ----- */
+				+ SVerticalBox::Slot().AutoHeight().Padding(6, 4, 6, 0)
+				[
+					SNew(SExpandableArea)
+						.InitiallyCollapsed(true)
+						.Visibility_Lambda([this]() { return StatsText.IsEmpty() ? EVisibility::Collapsed : EVisibility::Visible; })
+						.AreaTitle(LOCTEXT("StatsTitle", "Scan statistics"))
+						.BodyContent()
+						[
+							SNew(STextBlock)
+								.Font(FCoreStyle::GetDefaultFontStyle("Mono", 9))
+								.Text_Lambda([this]() { return StatsText; })
+						]
+				]
+
 				/* ---------------- lista -------------------- */
 				+ SVerticalBox::Slot().FillHeight(1).Padding(6)
 				[
@@ -101,18 +222,233 @@ void SPluginOptimizerDialog::Construct(const FArguments& InArgs)
 /* ------------------------------------------------------------------ */
 void SPluginOptimizerDialog::RefreshHeader()
 {
+	if (bScanning)
+	{
+		HeaderText->SetText(LOCTEXT("Scanning", "Scanning project..."));
+		return;
+	}
+
 	const int32 Potential = Items.Num();
 	FString Txt = FString::Printf(TEXT("Enabled: %d | Used: %d | Potentially Unused: %d"),
 		EnabledCnt, UsedCnt, Potential);
 	HeaderText->SetText(FText::FromString(Txt));
 }
 
+/* ------------------------------------------------------------------ */
+/*  SCAN ASSNCRONO                                                   */
+/* ------------------------------------------------------------------ */
+void SPluginOptimizerDialog::SetScanProgress(const FPluginScanProgress& Progress)
+{
+	ScanPhaseText = Progress.GetPhaseText();
+	ScanFraction = Progress.Fraction >= 0.f ? TOptional<float>(Progress.Fraction) : TOptional<float>();
+}
+
+void SPluginOptimizerDialog::SetScanResult(const TArray<FString>& Candidates, int32 EnabledCount, int32 UsedCount,
+	const TMap<FString, TArray<FString>>& InRemovableWith)
+{
+	bScanning = false;
+	EnabledCnt = EnabledCount;
+	UsedCnt = UsedCount;
+	RemovableWith = InRemovableWith;
+
+	Items.Reset();
+	for (const FString& Name : Candidates)
+		Items.Add(MakeShared<FString>(Name));
+
+	/* live tracking atualiza a lista com o select-mode aberto: mantm a seleo */
+	Selected = Selected.Intersect(TSet<FString>(Candidates));
+	ApplySort();
+
+	RefreshHeader();
+	ListView->RequestListRefresh();
+}
+
+void SPluginOptimizerDialog::SetScanStats(const FPluginScanStats& Stats)
+{
+	StatsText = FText::FromString(Stats.ToString());
+}
+
+void SPluginOptimizerDialog::SetUsedPlugins(const FPluginScanResult& Result)
+{
+	UsedItems.Reset();
+	UsedInfo.Reset();
+	for (int32 Idx = 0; Idx < Result.EnabledPlugins.Num(); ++Idx)
+	{
+		if (Result.UsageReasons[Idx] == EPluginUsageReason::None)
+			continue;
+
+		const FString& Name = Result.EnabledPlugins[Idx];
+		UsedItems.Add(MakeShared<FString>(Name));
+		UsedInfo.Add(Name, { Idx, Result.UsageReasons[Idx] });
+	}
+	UsedItems.Sort([](const TSharedPtr<FString>& A, const TSharedPtr<FString>& B) { return *A < *B; });
+
+	/* live tracking no coleta evidncias: mantm as do ltimo scan (mesmos ndices) */
+	if (Result.Evidence.IsValid())
+		Evidence = Result.Evidence;
+	EvidenceTips.Reset();
+
+	if (bShowUsed)
+		ListView->RequestListRefresh();
+}
+
+/* ------------------------------------------------------------------ */
+/*  PERFIL DE STARTUP                                                  */
+/* ------------------------------------------------------------------ */
+void SPluginOptimizerDialog::SetStartupCosts(const TMap<FString, FPluginStartupCost>& Costs)
+{
+	StartupCosts = Costs;
+	ApplySort();
+	ListView->RebuildList();
+}
+
+FPluginStartupCost SPluginOptimizerDialog::GetSavings(const FString& PluginName) const
+{
+	FPluginStartupCost Sum;
+	auto Add = [&](const FString& Name)
+		{
+			if (const FPluginStartupCost* Cost = StartupCosts.Find(Name))
+			{
+				Sum.Milliseconds += Cost->Milliseconds;
+				Sum.MemoryBytes += Cost->MemoryBytes;
+				Sum.NumModules += Cost->NumModules;
+			}
+		};
+
+	Add(PluginName);
+	if (const TArray<FString>* Group = RemovableWith.Find(PluginName))
+		for (const FString& Name : *Group) Add(Name);
+	return Sum;
+}
+
+/* ------------------------------------------------------------------ */
+/*  TAMANHO EM DISCO                                                   */
+/* ------------------------------------------------------------------ */
+void SPluginOptimizerDialog::SetDiskSizes(const TMap<FString, FPluginDiskSize>& Sizes)
+{
+	DiskSizes = Sizes;
+	ApplySort();
+	ListView->RebuildList();
+}
+
+FPluginDiskSize SPluginOptimizerDialog::GetDiskSavings(const FString& PluginName) const
+{
+	FPluginDiskSize Sum;
+	if (const FPluginDiskSize* Size = DiskSizes.Find(PluginName))
+		Sum += *Size;
+	if (const TArray<FString>* Group = RemovableWith.Find(PluginName))
+		for (const FString& Name : *Group)
+			if (const FPluginDiskSize* Size = DiskSizes.Find(Name))
+				Sum += *Size;
+	return Sum;
+}
+
+void SPluginOptimizerDialog::ApplySort()
+{
+	auto ByName = [](const TSharedPtr<FString>& A, const TSharedPtr<FString>& B) { return *A < *B; };
+
+	const bool bDisk = SortMode == ECandidateSort::DiskSize;
+	if (SortMode == ECandidateSort::Name || (bDisk ? DiskSizes.IsEmpty() : StartupCosts.IsEmpty()))
+	{
+		Items.Sort(ByName);
+		return;
+	}
+
+	/* mais caro primeiro; empate (ou sem medida) cai no nome */
+	const bool bTime = SortMode == ECandidateSort::StartupTime;
+	TMap<FString, double> Keys;
+	for (const TSharedPtr<FString>& It : Items)
+	{
+		if (bDisk)
+		{
+			Keys.Add(*It, double(GetDiskSavings(*It).GetTotal()));
+			continue;
+		}
+		const FPluginStartupCost S = GetSavings(*It);
+		Keys.Add(*It, bTime ? S.Milliseconds : double(S.MemoryBytes));
+	}
+
+	Items.Sort([&](const TSharedPtr<FString>& A, const TSharedPtr<FString>& B)
+		{
+			const double KA = Keys[*A], KB = Keys[*B];
+			return KA != KB ? KA > KB : *A < *B;
+		});
+}
+
+FReply SPluginOptimizerDialog::OnSortClicked()
+{
+	SortMode = ECandidateSort((uint8(SortMode) + 1) % uint8(ECandidateSort::Num));
+	ApplySort();
+	ListView->RequestListRefresh();
+	return FReply::Handled();
+}
+
+void SPluginOptimizerDialog::SetScanDiff(const FPluginScanDiff& Diff, const FDateTime& PreviousScan)
+{
+	if (Diff.IsEmpty())
+	{
+		DiffText = FText::Format(LOCTEXT("DiffNone", "No changes since the scan of {0}."),
+			FText::AsDateTime(PreviousScan));
+		DiffTip = FText::GetEmpty();
+		return;
+	}
+
+	DiffText = FText::Format(LOCTEXT("DiffSummary", "Since the scan of {0}: {1} newly used, {2} newly unused, {3} enabled, {4} disabled."),
+		FText::AsDateTime(PreviousScan), Diff.NewlyUsed.Num(), Diff.NewlyUnused.Num(), Diff.Added.Num(), Diff.Removed.Num());
+	DiffTip = FText::FromString(Diff.ToString());
+}
+
+FReply SPluginOptimizerDialog::OnCancelScanClicked()
+{
+	OnCancelScan.ExecuteIfBound();
+	return FReply::Handled();
+}
+
 /* ------------------------------------------------------------------ */
 /*  LINHA DA LISTA  checkbox na direita                              */
 /* ------------------------------------------------------------------ */
 TSharedRef<ITableRow> SPluginOptimizerDialog::OnGenerateRow(
 	TSharedPtr<FString> Item, const TSharedRef<STableViewBase>& Owner)
 {
+	if (bShowUsed)
+		return GenerateUsedRow(Item, Owner);
+
+	/* dependentes e dependncias rfs saem junto com o plugin */
+	const TArray<FString>* Group = RemovableWith.Find(*Item);
+
+	FText Label = FText::FromString(*Item);
+	FText GroupTip;
+	if (Group)
+	{
+		Label = FText::Format(LOCTEXT("RowWithGroup", "{0} (+{1})"), Label, Group->Num());
+		GroupTip = FText::Format(LOCTEXT("RowGroupTip", "Disabling this plugin also disables:\n{0}"),
+			FText::FromString(FString::Join(*Group, TEXT("\n"))));
+	}
+
+	/* custo de startup medido (plugin + grupo); vazio se nenhum mdulo foi medido */
+	FNumberFormattingOptions OneDecimal;
+	OneDecimal.SetMaximumFractionalDigits(1);
+
+	FText CostText;
+	const FPluginStartupCost Savings = GetSavings(*Item);
+	if (Savings.NumModules > 0)
+	{
+		CostText = FText::Format(LOCTEXT("RowCost", "~{0} ms | ~{1} MB"),
+			FText::AsNumber(Savings.Milliseconds, &OneDecimal),
+			FText::AsNumber(double(Savings.MemoryBytes) / (1024.0 * 1024.0), &OneDecimal));
+	}
+
+	/* tamanho em disco (plugin + grupo), detalhado por pasta no tooltip */
+	FText DiskText, DiskTip;
+	const FPluginDiskSize Disk = GetDiskSavings(*Item);
+	if (Disk.GetTotal() > 0)
+	{
+		DiskText = FText::Format(LOCTEXT("RowDisk", "{0} on disk"), FText::AsMemory(Disk.GetTotal()));
+		DiskTip = FText::Format(LOCTEXT("RowDiskTip", "Binaries: {0}\nContent: {1}\nShaders: {2}\nResources: {3}"),
+			FText::AsMemory(Disk.Binaries), FText::AsMemory(Disk.Content),
+			FText::AsMemory(Disk.Shaders), FText::AsMemory(Disk.Resources));
+	}
+
 	return SNew(STableRow<TSharedPtr<FString>>, Owner)
 		[
 			SNew(SHorizontalBox)
@@ -120,7 +456,29 @@ TSharedRef<ITableRow> SPluginOptimizerDialog::OnGenerateRow(
 				/* nome do plugin */
 				+ SHorizontalBox::Slot().FillWidth(1).VAlign(VAlign_Center).Padding(4, 0)
 				[
-					SNew(STextBlock).Text(FText::FromString(*Item))
+					SNew(STextBlock)
+						.Text(Label)
+						.ToolTipText(GroupTip)
+				]
+
+				/* custo de startup */
+				+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(4, 0)
+				[
+					SNew(STextBlock)
+						.Text(CostText)
+						.ToolTipText(LOCTEXT("RowCostTip", "Approximate startup cost from the last editor session: time and process memory spent in each module's StartupModule, excluding nested module loads. DLL loading is not included."))
+						.ColorAndOpacity(FSlateColor::UseSubduedForeground())
+						.Visibility(CostText.IsEmpty() ? EVisibility::Collapsed : EVisibility::Visible)
+				]
+
+				/* tamanho em disco */
+				+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(4, 0)
+				[
+					SNew(STextBlock)
+						.Text(DiskText)
+						.ToolTipText(DiskTip)
+						.ColorAndOpacity(FSlateColor::UseSubduedForeground())
+						.Visibility(DiskText.IsEmpty() ? EVisibility::Collapsed : EVisibility::Visible)
 				]
 
 				/* boto Disable individual */
@@ -129,6 +487,7 @@ TSharedRef<ITableRow> SPluginOptimizerDialog::OnGenerateRow(
 					SNew(SButton)
 						.Text(LOCTEXT("DisableRow", "Disable"))
 						.Visibility_Lambda([this]() { return bSelectMode ? EVisibility::Collapsed : EVisibility::Visible; })
+						.ToolTipText(GroupTip)
 						.OnClicked_Lambda([this, Item]()
 							{
 								DisableOne(*Item);
@@ -147,6 +506,75 @@ TSharedRef<ITableRow> SPluginOptimizerDialog::OnGenerateRow(
 		];
 }
 
+/* ------------------------------------------------------------------ */
+/*  LINHA DE PLUGIN USADO  motivo + evidncias no tooltip            */
+/* ------------------------------------------------------------------ */
+TSharedRef<ITableRow> SPluginOptimizerDialog::GenerateUsedRow(
+	TSharedPtr<FString> Item, const TSharedRef<STableViewBase>& Owner)
+{
+	const FUsedInfo* Info = UsedInfo.Find(*Item);
+	const FString Reasons = Info ? LexToString(Info->Reasons) : FString();
+
+	return SNew(STableRow<TSharedPtr<FString>>, Owner)
+		.ToolTipText_Lambda([this, Item]() { return GetEvidenceTip(*Item); })
+		[
+			SNew(SHorizontalBox)
+
+				+ SHorizontalBox::Slot().FillWidth(1).VAlign(VAlign_Center).Padding(4, 0)
+				[
+					SNew(STextBlock).Text(FText::FromString(*Item))
+				]
+
+				+ SHorizontalBox::Slot().AutoWidth().VAlign(VAlign_Center).Padding(4, 0)
+				[
+					SNew(STextBlock)
+						.Text(FText::FromString(Reasons))
+						.ColorAndOpacity(FSlateColor::UseSubduedForeground())
+				]
+		];
+}
+
+/* montado na primeira vez que o tooltip aparece e guardado at o prximo resultado */
+FText SPluginOptimizerDialog::GetEvidenceTip(const FString& PluginName) const
+{
+	if (const FText* Cached = EvidenceTips.Find(PluginName))
+		return *Cached;
+
+	const FUsedInfo* Info = UsedInfo.Find(PluginName);
+	if (!Info)
+		return FText::GetEmpty();
+
+	FTextBuilder Tip;
+	Tip.AppendLine(FText::Format(LOCTEXT("EvidenceReasons", "Used because of: {0}"),
+		FText::FromString(LexToString(Info->Reasons))));
+
+	if (Evidence.IsValid() && Info->PluginIdx < Evidence->GetNumPlugins())
+	{
+		const TConstArrayView<FPluginEvidence> Entries = Evidence->Get(Info->PluginIdx);
+		const int32 Shown = FMath::Min(Entries.Num(), MaxEvidenceInTip);
+		for (int32 i = 0; i < Shown; ++i)
+			Tip.AppendLine(Evidence->Describe(Entries[i]));
+
+		const int32 More = Evidence->GetTotalHits(Info->PluginIdx) - Shown;
+		if (More > 0)
+			Tip.AppendLine(FText::Format(LOCTEXT("EvidenceMore", "...and {0} more"), More));
+	}
+
+	return EvidenceTips.Add(PluginName, Tip.ToText());
+}
+
+void SPluginOptimizerDialog::SetShowUsed(bool bShow)
+{
+	bShowUsed = bShow;
+
+	/* usados no entram no select-mode */
+	if (bShowUsed && bSelectMode)
+		OnSelectClicked();
+
+	ListView->SetItemsSource(bShowUsed ? &UsedItems : &Items);
+	ListView->RebuildList();
+}
+
 /* ------------------------------------------------------------------ */
 /*  BOTES DO TOPO                                                     */
 /* ------------------------------------------------------------------ */
@@ -158,6 +586,7 @@ FReply SPluginOptimizerDialog::OnSelectClicked()
 	const EVisibility SelVis = bSelectMode ? EVisibility::Visible : EVisibility::Collapsed;
 	SelectAllBtn->SetVisibility(SelVis);
 	DisableSelectedBtn->SetVisibility(SelVis);
+	TrialSelectedBtn->SetVisibility(SelVis);
 
 	ListView->RequestListRefresh();
 	return FReply::Handled();
@@ -187,11 +616,56 @@ FReply SPluginOptimizerDialog::OnDisableSelectedClicked()
 		return FReply::Handled();
 	}
 
-	const TArray<FString> ToDisable = Selected.Array();
-	DisableMultiple(ToDisable);
+	DisableMultiple(GetSelectedWithGroups());
+	return FReply::Handled();
+}
+
+FReply SPluginOptimizerDialog::OnTrialSelectedClicked()
+{
+	if (Selected.IsEmpty())
+	{
+		FMessageDialog::Open(EAppMsgType::Ok,
+			LOCTEXT("NoneSelected", "No plugins selected."));
+		return FReply::Handled();
+	}
+
+	const TArray<FString> ToDisable = GetSelectedWithGroups();
+	FPluginTrialUnload Trial;
+	FText Fail;
+	if (!Trial.Begin(ToDisable, Fail))
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, Fail);
+		return FReply::Handled();
+	}
+
+	/* fechar o pop-up sem escolher = restaurar */
+	if (!ShowTrialPopup(Trial))
+	{
+		Trial.Restore();
+		return FReply::Handled();
+	}
+
+	if (!Trial.Commit(Fail))
+	{
+		FMessageDialog::Open(EAppMsgType::Ok, Fail);
+		return FReply::Handled();
+	}
+
+	RemoveDisabled(ToDisable);
+	ShowRestartPopup(ToDisable.Num());
 	return FReply::Handled();
 }
 
+/* o grupo de cada selecionado vai junto (seno a validao recusa) */
+TArray<FString> SPluginOptimizerDialog::GetSelectedWithGroups() const
+{
+	TSet<FString> ToDisable = Selected;
+	for (const FString& Name : Selected)
+		if (const TArray<FString>* Group = RemovableWith.Find(Name))
+			ToDisable.Append(*Group);
+	return ToDisable.Array();
+}
+
 /* ------------------------------------------------------------------ */
 /*  CHECKBOX                                                          */
 /* ------------------------------------------------------------------ */
@@ -211,42 +685,131 @@ ECheckBoxState SPluginOptimizerDialog::IsItemChecked(TSharedPtr<FString> Item) c
 /* ------------------------------------------------------------------ */
 bool SPluginOptimizerDialog::DisableOne(const FString& PluginName)
 {
-	IProjectManager& ProjMgr = IProjectManager::Get();
-	FText Fail;
+	TArray<FString> ToDisable = { PluginName };
+	if (const TArray<FString>* Group = RemovableWith.Find(PluginName))
+		ToDisable.Append(*Group);
+	return DisableMultiple(ToDisable);
+}
 
-	if (!ProjMgr.SetPluginEnabled(PluginName, false, Fail))
+/* ------------------------------------------------------------------ */
+/*  DESATIVAR VRIOS PLUGINS                                          */
+/* ------------------------------------------------------------------ */
+bool SPluginOptimizerDialog::DisableMultiple(const TArray<FString>& ToDisable)
+{
+	// Tudo ou nada: uma nica escrita do .uproject; em caso de falha nada muda
+	FText Fail;
+	if (!FPluginDisableBatch::Apply(ToDisable, Fail))
 	{
-		FMessageDialog::Open(EAppMsgType::Ok,
-			FText::Format(LOCTEXT("DisableFailed", "Failed to disable plugin:\n{0}\n\n{1}"),
-				FText::FromString(PluginName), Fail));
+		FMessageDialog::Open(EAppMsgType::Ok, Fail);
 		return false;
 	}
 
-	ProjMgr.SaveCurrentProjectToDisk(Fail);
+	RemoveDisabled(ToDisable);
+	ShowRestartPopup(ToDisable.Num());
+	return true;
+}
 
-	Items.RemoveAll([&](const TSharedPtr<FString>& Ptr) { return *Ptr == PluginName; });
-	Selected.Remove(PluginName);
+void SPluginOptimizerDialog::RemoveDisabled(const TArray<FString>& ToDisable)
+{
+	const TSet<FString> Disabled(ToDisable);
+	Items.RemoveAll([&](const TSharedPtr<FString>& Ptr) { return Disabled.Contains(*Ptr); });
+	Selected = Selected.Difference(Disabled);
 	RefreshHeader();
 	ListView->RequestListRefresh();
-
-	ShowRestartPopup();
-	return true;
 }
 
 /* ------------------------------------------------------------------ */
-/*  DESATIVAR VRIOS PLUGINS                                          */
+/*  POP-UP do teste (true = desativar, false = restaurar)            */
 /* ------------------------------------------------------------------ */
-void SPluginOptimizerDialog::DisableMultiple(const TArray<FString>& ToDisable)
+bool SPluginOptimizerDialog::ShowTrialPopup(const FPluginTrialUnload& Trial)
 {
-	for (const FString& P : ToDisable)
-		DisableOne(P);
-	ShowRestartPopup();
+	const int64 Reclaimed = Trial.GetReclaimedBytes();
+	FTextBuilder Msg;
+	Msg.AppendLine(FText::Format(LOCTEXT("TrialUnloaded", "{0}|plural(one=Plugin,other={0} plugins) unloaded."),
+		Trial.GetPlugins().Num()));
+	Msg.AppendLine(Reclaimed > 0
+		? FText::Format(LOCTEXT("TrialReclaimed", "Memory reclaimed: at least {0}"), FText::AsMemory(uint64(Reclaimed)))
+		: LOCTEXT("TrialNoReclaim", "Memory reclaimed: none measurable"));
+	Msg.AppendLine(LOCTEXT("TrialLowerBound", "This is a lower bound: modules with UObjects stay loaded until the editor restarts."));
+
+	if (Trial.GetModulesKeptLoaded().Num())
+	{
+		TArray<FString> Names;
+		for (const FName Module : Trial.GetModulesKeptLoaded()) Names.Add(Module.ToString());
+		Msg.AppendLine(FText::Format(LOCTEXT("TrialKept", "Kept loaded until restart: {0}"),
+			FText::FromString(FString::Join(Names, TEXT(", ")))));
+	}
+
+	const TArray<FName>& Broken = Trial.GetBrokenPackages();
+	if (Broken.Num())
+	{
+		constexpr int32 MaxListed = 20;
+		Msg.AppendLine();
+		Msg.AppendLine(FText::Format(LOCTEXT("TrialBroken", "{0}|plural(one=One /Game package,other={0} /Game packages) would fail to load after disabling:"),
+			Broken.Num()));
+		for (int32 Idx = 0; Idx < FMath::Min(Broken.Num(), MaxListed); ++Idx)
+			Msg.AppendLine(FText::FromName(Broken[Idx]));
+		if (Broken.Num() > MaxListed)
+			Msg.AppendLine(FText::Format(LOCTEXT("TrialBrokenMore", "... and {0} more"), Broken.Num() - MaxListed));
+	}
+	else
+	{
+		Msg.AppendLine(LOCTEXT("TrialNoBroken", "No dependent /Game package would fail to load."));
+	}
+
+	bool bDisable = false;
+	TSharedRef<SWindow> Win = SNew(SWindow)
+		.Title(LOCTEXT("TrialPopupTitle", "Plugin Optimizer - Trial"))
+		.ClientSize(FVector2D(480, 260))
+		.SupportsMinimize(false)
+		.SupportsMaximize(false);
+
+	Win->SetContent(
+		SNew(SVerticalBox)
+
+		+ SVerticalBox::Slot().FillHeight(1).Padding(10)
+		[
+			SNew(STextBlock)
+				.AutoWrapText(true)
+				.Text(Msg.ToText())
+		]
+
+		+ SVerticalBox::Slot().AutoHeight().HAlign(HAlign_Right).Padding(0, 0, 10, 10)
+		[
+			SNew(SHorizontalBox)
+
+			+ SHorizontalBox::Slot().AutoWidth().Padding(4, 0)
+			[
+				SNew(SButton)
+					.Text(LOCTEXT("TrialRestore", "Restore"))
+					.OnClicked_Lambda([Win]()
+						{
+							Win->RequestDestroyWindow();
+							return FReply::Handled();
+						})
+			]
+
+			+ SHorizontalBox::Slot().AutoWidth().Padding(4, 0)
+			[
+				SNew(SButton)
+					.Text(LOCTEXT("TrialDisable", "Disable"))
+					.OnClicked_Lambda([Win, &bDisable]()
+						{
+							bDisable = true;
+							Win->RequestDestroyWindow();
+							return FReply::Handled();
+						})
+			]
+		]);
+
+	FSlateApplication::Get().AddModalWindow(Win, nullptr);
+	return bDisable;
 }
 
 /* ------------------------------------------------------------------ */
 /*  POP-UP Restart required                                         */
 /* ------------------------------------------------------------------ */
-void SPluginOptimizerDialog::ShowRestartPopup()
+void SPluginOptimizerDialog::ShowRestartPopup(int32 NumDisabled)
 {
 	if (bSuppressRestartPopup)
 		return;
@@ -265,8 +828,9 @@ void SPluginOptimizerDialog::ShowRestartPopup()
 		[
 			SNew(STextBlock)
 				.AutoWrapText(true)
-				.Text(LOCTEXT("RestartPopupMsg",
-					"Plugin disabled.\nPlease restart the editor to finish unloading."))
+				.Text(FText::Format(LOCTEXT("RestartPopupMsg",
+					"{0}|plural(one=Plugin,other={0} plugins) disabled.\nPlease restart the editor to finish unloading."),
+					NumDisabled))
 		]
 
 		+ SVerticalBox::Slot().AutoHeight().Padding(10, 0, 10, 10)
@@ -0,0 +1,44 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "PluginConfigScanner.h"
+#include "PluginScanTestUtils.h"
+
+using namespace PluginScanTests;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPluginConfigIniTest, "PluginOptimizer.Config.Ini",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPluginConfigIniTest::RunTest(const FString& Parameters)
+{
+	const FPluginModuleResolver Resolver = MakeTestResolver();
+	const FAnsiStringView Text =
+		"[/Script/PoTestModuleA.Settings]\r\n"
+		"; Value=/Script/PoTestModuleB.Foo\r\n"
+		"  # Value=/Script/PoTestModuleC.Foo\r\n"
+		"+ActiveClassRedirects=(OldName=\"/Script/PoTestModuleC.Old\",NewName=\"/Script/Engine.New\")\r\n"
+		"+ClassRedirects = (OldName=\"/Script/PoTestModuleC.Old\")\r\n"
+		"DefaultClass=/Script/PoTestModuleD.Bar\r\n";
+
+	TBitArray<> Used(false, NumTestPlugins);
+	PluginScan::ParseIni(Text, Resolver, nullptr, NAME_None, Used);
+	TestEqual(TEXT("Sections and values outside comments and redirects"), UsedToString(Used), FString(TEXT("AD")));
+
+	// UTF-16 com BOM passa pelo mesmo tokenizador
+	const FString Wide = TEXT("[Core.Log]\r\n;X=/Script/PoTestModuleA.Foo\r\nY=/Script/PoTestModuleE.Bar\r\n");
+	TArray<uint8> Bytes = { 0xFF, 0xFE };
+	for (const TCHAR C : Wide)
+	{
+		Bytes.Add(uint8(C & 0xFF));
+		Bytes.Add(uint8(C >> 8));
+	}
+
+	TBitArray<> UsedWide(false, NumTestPlugins);
+	PluginScan::ParseIni(FAnsiStringView(reinterpret_cast<const ANSICHAR*>(Bytes.GetData()), Bytes.Num()),
+		Resolver, nullptr, NAME_None, UsedWide);
+	TestEqual(TEXT("UTF-16 file"), UsedToString(UsedWide), FString(TEXT("E")));
+	return true;
+}
+
+#endif
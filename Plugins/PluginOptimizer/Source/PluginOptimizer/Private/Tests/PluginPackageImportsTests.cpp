@@ -0,0 +1,67 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "PluginPackageImports.h"
+
+#include "Curves/CurveFloat.h"
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/PackageName.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+#include "UObject/Package.h"
+#include "UObject/SavePackage.h"
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPluginPackageImportsTest, "PluginOptimizer.PackageImports.Header",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPluginPackageImportsTest::RunTest(const FString& Parameters)
+{
+	// pacote transitório com um UCurveFloat: importa a classe de /Script/Engine
+	UPackage* Package = CreatePackage(*MakeUniqueObjectName(nullptr, UPackage::StaticClass(),
+		FName(TEXT("/Temp/PluginOptimizerImportsTest"))).ToString());
+	UCurveFloat* Curve = NewObject<UCurveFloat>(Package, TEXT("Curve"), RF_Public | RF_Standalone);
+
+	const FString Filename = FPaths::CreateTempFilename(*FPaths::ProjectIntermediateDir(), TEXT("PoImportsTest"),
+		*FPackageName::GetAssetPackageExtension());
+	ON_SCOPE_EXIT
+	{
+		IFileManager::Get().Delete(*Filename, false, true, true);
+		Curve->ClearFlags(RF_Public | RF_Standalone);
+		Curve->MarkAsGarbage();
+		Package->MarkAsGarbage();
+	};
+
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+	if (!TestTrue(TEXT("Package saved"), UPackage::SavePackage(Package, Curve, *Filename, SaveArgs)))
+		return false;
+
+	TArray<uint8> Bytes;
+	if (!TestTrue(TEXT("Package read back"), FFileHelper::LoadFileToArray(Bytes, *Filename)))
+		return false;
+
+	TArray<FName> ScriptPackages;
+	int64 HeaderSize = 0;
+	TestTrue(TEXT("Header parsed"), PluginScan::ReadScriptImports(Bytes, ScriptPackages, HeaderSize));
+	TestTrue(TEXT("Imports /Script/Engine"), ScriptPackages.Contains(FName(TEXT("/Script/Engine"))));
+
+	// header cortado: false e o tamanho que falta ler
+	if (HeaderSize > 1 && HeaderSize <= Bytes.Num())
+	{
+		ScriptPackages.Reset();
+		int64 TruncatedSize = 0;
+		TestFalse(TEXT("Truncated header"), PluginScan::ReadScriptImports(
+			TConstArrayView<uint8>(Bytes.GetData(), int32(HeaderSize - 1)), ScriptPackages, TruncatedSize));
+		TestEqual(TEXT("Truncated header size"), TruncatedSize, HeaderSize);
+	}
+
+	// não é um pacote
+	const uint8 Garbage[] = { 'n', 'o', 't', ' ', 'a', ' ', 'p', 'k', 'g' };
+	ScriptPackages.Reset();
+	TestFalse(TEXT("Not a package"), PluginScan::ReadScriptImports(Garbage, ScriptPackages, HeaderSize));
+	return true;
+}
+
+#endif
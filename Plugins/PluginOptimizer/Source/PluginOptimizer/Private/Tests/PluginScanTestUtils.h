@@ -0,0 +1,28 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "PluginModuleResolver.h"
+
+/* Helpers compartilhados pelos testes de automação do scanner */
+namespace PluginScanTests
+{
+	// Um módulo por plugin: PoTestModuleA -> 0, B -> 1...
+	constexpr int32 NumTestPlugins = 5;
+
+	inline FPluginModuleResolver MakeTestResolver()
+	{
+		FPluginModuleResolver Resolver;
+		for (int32 Idx = 0; Idx < NumTestPlugins; ++Idx)
+			Resolver.AddModule(FName(*FString::Printf(TEXT("PoTestModule%c"), TCHAR('A' + Idx))), Idx);
+		return Resolver;
+	}
+
+	// "AD" = plugins 0 e 3
+	inline FString UsedToString(const TBitArray<>& Used)
+	{
+		FString Out;
+		for (TConstSetBitIterator<> It(Used); It; ++It)
+			Out.AppendChar(TCHAR('A' + It.GetIndex()));
+		return Out;
+	}
+}
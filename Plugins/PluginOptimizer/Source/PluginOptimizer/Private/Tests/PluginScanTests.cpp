@@ -0,0 +1,112 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "PluginScanCommon.h"
+#include "PluginSyntheticRegistry.h"
+
+namespace
+{
+	// Poucas referências: parte dos plugins fica sem uso e o resultado não é trivial
+	FSyntheticRegistrySettings MakeTestSettings(int32 Seed)
+	{
+		FSyntheticRegistrySettings Settings;
+		Settings.NumAssets = 2000;
+		Settings.NumPlugins = 40;
+		Settings.AssetsPerPlugin = 4;
+		Settings.PluginDependencyRatio = 0.3f;
+		Settings.ClassTagRatio = 0.005f;
+		Settings.InterfaceTagRatio = 0.002f;
+		Settings.PluginContentRatio = 0.002f;
+		Settings.Seed = Seed;
+		return Settings;
+	}
+
+	// só as passadas que leem o registry, sem cache em disco
+	FPluginScanOptions MakeTestOptions(EPluginReferencePass Pass, int32 BatchSize)
+	{
+		FPluginScanOptions Options;
+		Options.ReferencePass = Pass;
+		Options.AssetBatchSize = BatchSize;
+		Options.bUseCache = false;
+		Options.bScanSource = false;
+		Options.bScanConfig = false;
+		Options.bCheckLoadedModules = false;
+		return Options;
+	}
+
+	PluginScan::FScanPlugin MakeLayerPlugin(const TCHAR* Name, const TCHAR* BaseDir)
+	{
+		PluginScan::FScanPlugin P;
+		P.Name = Name;
+		P.BaseDir = BaseDir;
+		P.MountPath = FString::Printf(TEXT("/%s/"), Name);
+		P.Modules.Add(FName(*FString::Printf(TEXT("%sModule"), Name)));
+		return P;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPluginScanSyntheticTest, "PluginOptimizer.Scan.Synthetic",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPluginScanSyntheticTest::RunTest(const FString& Parameters)
+{
+	for (const int32 Seed : { 1234, 98765 })
+	{
+		const FSyntheticScanSource Source(MakeTestSettings(Seed));
+		const TBitArray<>& Expected = Source.GetExpectedUsed();
+		TestTrue(FString::Printf(TEXT("Seed %d: some plugins used, some not"), Seed),
+			Expected.Contains(true) && Expected.Contains(false));
+
+		for (const EPluginReferencePass Pass : { EPluginReferencePass::GameDependencies, EPluginReferencePass::PluginReferencers })
+		{
+			// lote pequeno: vários lotes de /Game por scan
+			for (const int32 BatchSize : { 64, 100000 })
+			{
+				FPluginScanResult Result;
+				PluginScan::FScanContext Ctx;
+				const bool bCompleted = PluginScan::RunScan(Source.GetPlugins(), MakeTestOptions(Pass, BatchSize), Source, Ctx, Result);
+
+				const FString What = FString::Printf(TEXT("Seed %d, pass %d, batch %d"), Seed, int32(Pass), BatchSize);
+				TestTrue(What + TEXT(": completed"), bCompleted);
+				TestTrue(What + TEXT(": used set matches the generator"), Result.Used == Expected);
+			}
+		}
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPluginScanBaseLayerTest, "PluginOptimizer.Scan.BaseLayer",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPluginScanBaseLayerTest::RunTest(const FString& Parameters)
+{
+	PluginScan::FPluginBaseIndex Base;
+	Base.Plugins.Add(MakeLayerPlugin(TEXT("PoLayerA"), TEXT("/Engine/Plugins/PoLayerA")));
+	Base.Plugins.Add(MakeLayerPlugin(TEXT("PoLayerB"), TEXT("/Engine/Plugins/PoLayerB")));
+	Base.Plugins.Add(MakeLayerPlugin(TEXT("PoLayerC"), TEXT("/Engine/Plugins/PoLayerC")));
+	PluginScan::BuildResolver(Base.Plugins, Base.Resolver);
+
+	// B vem do engine; C é substituído pelo do projeto; A não está habilitado
+	TArray<PluginScan::FScanPlugin> Plugins;
+	Plugins.Add(MakeLayerPlugin(TEXT("PoLayerB"), TEXT("/Engine/Plugins/PoLayerB")));
+	Plugins.Add(MakeLayerPlugin(TEXT("PoLayerC"), TEXT("/Project/Plugins/PoLayerC")));
+	Plugins.Add(MakeLayerPlugin(TEXT("PoLayerD"), TEXT("/Project/Plugins/PoLayerD")));
+
+	PluginScan::FPluginBaseLayer Layer;
+	FPluginModuleResolver Resolver;
+	PluginScan::BuildResolver(Plugins, &Base, Layer, Resolver);
+
+	TestTrue(TEXT("Only the engine copy of B is covered"), Layer.Covered[0] && !Layer.Covered[1] && !Layer.Covered[2]);
+	TestEqual(TEXT("Disabled base plugin"), Resolver.FindByModuleName(FName(TEXT("PoLayerAModule"))), INDEX_NONE);
+	TestEqual(TEXT("Base module"), Resolver.FindByModuleName(FName(TEXT("PoLayerBModule"))), 0);
+	TestEqual(TEXT("Base script package"), Resolver.FindByPackageName(FName(TEXT("/Script/PoLayerBModule"))), 0);
+	TestEqual(TEXT("Base mount"), Resolver.FindByPackageName(FName(TEXT("/PoLayerB/Maps/Main"))), 0);
+	TestEqual(TEXT("Overridden module"), Resolver.FindByModuleName(FName(TEXT("PoLayerCModule"))), 1);
+	TestEqual(TEXT("Overridden mount"), Resolver.FindByPackageName(FName(TEXT("/PoLayerC/Maps/Main"))), 1);
+	TestEqual(TEXT("Project module"), Resolver.FindByModuleName(FName(TEXT("PoLayerDModule"))), 2);
+	TestEqual(TEXT("Only uncovered plugins in the layer"), Resolver.GetModules().Num(), 2);
+	return true;
+}
+
+#endif
@@ -0,0 +1,107 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "PluginSourceScanner.h"
+#include "PluginScanTestUtils.h"
+
+#include "HAL/FileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+
+using namespace PluginScanTests;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPluginSourceBuildCsTest, "PluginOptimizer.Source.BuildCs",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPluginSourceBuildCsTest::RunTest(const FString& Parameters)
+{
+	const FPluginModuleResolver Resolver = MakeTestResolver();
+	const FAnsiStringView Text =
+		"PublicDependencyModuleNames.AddRange(new string[] { \"Core\", \"PoTestModuleA\" });\n"
+		"// PrivateDependencyModuleNames.Add(\"PoTestModuleB\");\n"
+		"/* PrivateDependencyModuleNames.Add(\"PoTestModuleC\"); */\n"
+		"PrivateDependencyModuleNames.AddRange(new string[] {\n"
+		"\t\"PoTestModuleD\", // \"PoTestModuleE\"\n"
+		"});\n";
+
+	TBitArray<> Used(false, NumTestPlugins);
+	PluginScan::ParseBuildCs(Text, Resolver, nullptr, NAME_None, Used);
+	TestEqual(TEXT("Modules outside comments"), UsedToString(Used), FString(TEXT("AD")));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPluginSourceIncludesTest, "PluginOptimizer.Source.Includes",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPluginSourceIncludesTest::RunTest(const FString& Parameters)
+{
+	const FPluginModuleResolver Resolver = MakeTestResolver();
+	const FAnsiStringView Text =
+		"#include \"PoTestModuleA/Foo.h\"\n"
+		"// #include \"PoTestModuleB/Bar.h\"\n"
+		"/*\n"
+		"#include \"PoTestModuleC/Baz.h\"\n"
+		"*/\n"
+		"#if 0\n"
+		"#include \"PoTestModuleD/Qux.h\"\n"
+		"  #if WITH_EDITOR\n"
+		"  #include \"PoTestModuleD/Nested.h\"\n"
+		"  #endif\n"
+		"#else\n"
+		"#include <PoTestModuleE/Else.h>\n"
+		"#endif\n";
+
+	TBitArray<> Used(false, NumTestPlugins);
+	PluginScan::ParseIncludes(Text, Resolver, PluginScan::FIncludeIndex(), FStringView(), nullptr, NAME_None, Used);
+	TestEqual(TEXT("Includes outside comments and #if 0"), UsedToString(Used), FString(TEXT("AE")));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPluginSourceLocalHeadersTest, "PluginOptimizer.Source.LocalHeaders",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPluginSourceLocalHeadersTest::RunTest(const FString& Parameters)
+{
+	// projeto e plugins de mentira numa pasta temporária
+	const FString Root = FPaths::ConvertRelativePathToFull(FPaths::CreateTempFilename(*FPaths::ProjectIntermediateDir(), TEXT("PoSourceTest")));
+	ON_SCOPE_EXIT { IFileManager::Get().DeleteDirectory(*Root, false, true); };
+
+	TArray<PluginScan::FScanPlugin> Plugins;
+	for (int32 Idx = 0; Idx < NumTestPlugins; ++Idx)
+	{
+		PluginScan::FScanPlugin& P = Plugins.AddDefaulted_GetRef();
+		P.Name = FString::Printf(TEXT("PoTestPlugin%c"), TCHAR('A' + Idx));
+		P.BaseDir = Root / TEXT("Plugins") / P.Name;
+		P.Modules.Add(FName(*FString::Printf(TEXT("PoTestModule%c"), TCHAR('A' + Idx))));
+	}
+
+	auto Write = [](const FString& Path, const TCHAR* Text) { return FFileHelper::SaveStringToFile(Text, *Path); };
+
+	// B e C têm headers com nomes comuns; o projeto tem o próprio Types.h e Sub/Utils.h
+	bool bWritten = Write(Plugins[1].BaseDir / TEXT("Source/PoTestModuleB/Public/Types.h"), TEXT("#pragma once\n"))
+		&& Write(Plugins[2].BaseDir / TEXT("Source/PoTestModuleC/Public/Utils.h"), TEXT("#pragma once\n"))
+		&& Write(Plugins[3].BaseDir / TEXT("Source/PoTestModuleD/Public/Helper.h"), TEXT("#pragma once\n"))
+		&& Write(Root / TEXT("Source/Game/Public/Types.h"), TEXT("#pragma once\n"))
+		&& Write(Root / TEXT("Source/Game/Public/Sub/Utils.h"), TEXT("#pragma once\n"))
+		&& Write(Root / TEXT("Source/Game/Private/Game.cpp"), TEXT(
+			"#include \"Types.h\"\n"
+			"#include \"Utils.h\"\n"
+			"#include \"../Public/Sub/Utils.h\"\n"
+			"#include \"Helper.h\"\n"));
+	if (!TestTrue(TEXT("Test files written"), bWritten))
+		return false;
+
+	FPluginModuleResolver Resolver;
+	PluginScan::BuildResolver(Plugins, Resolver);
+
+	TBitArray<> Used(false, NumTestPlugins);
+	PluginScan::FScanContext Ctx;
+	TestTrue(TEXT("Scan completed"), PluginScan::ScanProjectSource(Root / TEXT("Source"), Plugins, Resolver,
+		TBitArray<>(false, NumTestPlugins), Ctx, Used));
+	TestEqual(TEXT("Only the plugin header the project lacks"), UsedToString(Used), FString(TEXT("D")));
+	return true;
+}
+
+#endif
@@ -0,0 +1,53 @@
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "PluginTargetAnalysis.h"
+
+using namespace PluginScan;
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FPluginTargetModuleFilterTest, "PluginOptimizer.Targets.ModuleFilters",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::EngineFilter)
+
+bool FPluginTargetModuleFilterTest::RunTest(const FString& Parameters)
+{
+	const FModuleTargetFilter None;
+	TestTrue(TEXT("Runtime, no lists"), IsModuleInTarget(EHostType::Runtime, None, EPluginBuildTarget::Server, TEXT("Linux")));
+	TestFalse(TEXT("ClientOnly on Server"), IsModuleInTarget(EHostType::ClientOnly, None, EPluginBuildTarget::Server, TEXT("Linux")));
+	TestFalse(TEXT("Developer in Shipping"), IsModuleInTarget(EHostType::Developer, None, EPluginBuildTarget::Game, TEXT("Win64")));
+
+	FModuleTargetFilter NoServer;
+	NoServer.TargetDenyList.Add(EBuildTargetType::Server);
+	TestFalse(TEXT("TargetDenyList"), IsModuleInTarget(EHostType::Runtime, NoServer, EPluginBuildTarget::Server, TEXT("Linux")));
+	TestTrue(TEXT("TargetDenyList, other target"), IsModuleInTarget(EHostType::Runtime, NoServer, EPluginBuildTarget::Client, TEXT("Linux")));
+
+	FModuleTargetFilter GameOnly;
+	GameOnly.TargetAllowList.Add(EBuildTargetType::Game);
+	TestFalse(TEXT("TargetAllowList"), IsModuleInTarget(EHostType::Runtime, GameOnly, EPluginBuildTarget::Client, TEXT("Win64")));
+
+	FModuleTargetFilter WindowsOnly;
+	WindowsOnly.PlatformAllowList.Add(TEXT("Win64"));
+	TestTrue(TEXT("PlatformAllowList"), IsModuleInTarget(EHostType::Runtime, WindowsOnly, EPluginBuildTarget::Game, TEXT("Win64")));
+	TestFalse(TEXT("PlatformAllowList, other platform"), IsModuleInTarget(EHostType::Runtime, WindowsOnly, EPluginBuildTarget::Game, TEXT("Linux")));
+
+	FModuleTargetFilter NoLinux;
+	NoLinux.PlatformDenyList.Add(TEXT("Linux"));
+	TestFalse(TEXT("PlatformDenyList"), IsModuleInTarget(EHostType::Runtime, NoLinux, EPluginBuildTarget::Server, TEXT("Linux")));
+
+	FModuleTargetFilter Explicit;
+	Explicit.bHasExplicitPlatforms = true;
+	TestFalse(TEXT("Explicit platforms, empty list"), IsModuleInTarget(EHostType::Runtime, Explicit, EPluginBuildTarget::Game, TEXT("Win64")));
+
+	FModuleTargetFilter NoShipping;
+	NoShipping.ConfigurationDenyList.Add(EBuildConfiguration::Shipping);
+	TestFalse(TEXT("ConfigurationDenyList"), IsModuleInTarget(EHostType::Runtime, NoShipping, EPluginBuildTarget::Game, TEXT("Win64")));
+
+	FScanPlugin Plugin;
+	TestTrue(TEXT("Plugin, all platforms"), IsPluginOnPlatform(Plugin, TEXT("Linux")));
+	Plugin.SupportedTargetPlatforms.Add(TEXT("Win64"));
+	TestTrue(TEXT("Plugin, supported platform"), IsPluginOnPlatform(Plugin, TEXT("Win64")));
+	TestFalse(TEXT("Plugin, unsupported platform"), IsPluginOnPlatform(Plugin, TEXT("Linux")));
+	return true;
+}
+
+#endif
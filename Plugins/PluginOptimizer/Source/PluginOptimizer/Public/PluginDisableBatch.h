@@ -0,0 +1,17 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*
+ * Desativa vários plugins com uma única escrita do .uproject. As mudanças são
+ * aplicadas em memória, validadas e gravadas uma vez; se algo falhar no meio,
+ * tudo o que já foi aplicado é desfeito e o descritor em disco não muda.
+ */
+struct FPluginDisableBatch
+{
+	static bool Apply(const TArray<FString>& PluginNames, FText& OutFailReason);
+
+	// Só a validação (plugins existem, estão habilitados e nenhum plugin que
+	// continua habilitado depende de um dos que vão sair)
+	static bool Validate(const TArray<FString>& PluginNames, FText& OutFailReason);
+};
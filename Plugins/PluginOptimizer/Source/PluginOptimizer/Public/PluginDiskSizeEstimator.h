@@ -0,0 +1,36 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/* Bytes em disco de um plugin, por pasta da raiz do plugin */
+struct FPluginDiskSize
+{
+	int64 Binaries = 0;     // Binaries/ (módulos compilados, .pdb)
+	int64 Content = 0;      // Content/ (.uasset, .umap, .ubulk...)
+	int64 Shaders = 0;      // Shaders/ (.usf, .ush)
+	int64 Resources = 0;    // Resources/ (ícones e afins)
+
+	int64 GetTotal() const { return Binaries + Content + Shaders + Resources; }
+
+	FPluginDiskSize& operator+=(const FPluginDiskSize& Other);
+};
+
+/*
+ * Mede o tamanho em disco de cada plugin percorrendo as pastas da raiz em
+ * paralelo. Cada pasta fica em cache (Saved/PluginOptimizer/DiskSizes.bin)
+ * com seu timestamp, o total dos arquivos diretos e as subpastas: pasta com
+ * o mesmo timestamp não é listada de novo. Arquivo reescrito no lugar não
+ * muda o timestamp da pasta, então o resultado é uma estimativa.
+ */
+class FPluginDiskSizeEstimator
+{
+public:
+	static FString GetDefaultCachePath();
+
+	// Plugin -> BaseDir. Bloqueia; pode rodar fora do game thread
+	static TMap<FString, FPluginDiskSize> Estimate(const TMap<FString, FString>& BaseDirs,
+		const FString& CachePath = GetDefaultCachePath());
+
+	// Plugins habilitados, em background; OnComplete roda no game thread
+	static void EstimateAsync(TFunction<void(TMap<FString, FPluginDiskSize>&&)> OnComplete);
+};
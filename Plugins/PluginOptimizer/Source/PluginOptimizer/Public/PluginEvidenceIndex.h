@@ -0,0 +1,82 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/* De onde veio um hit */
+enum class EPluginEvidenceKind : uint8
+{
+    AssetClass,             // classe do asset (Subject = pacote, Detail = asset)
+    ClassTag,               // tag de classe do asset (Tag = nome da tag)
+    PackageImport,          // tabela de imports do pacote (Subject = pacote, Detail = "/Script/Module")
+    PackageDependency,      // pacote de /Game depende de conteúdo do plugin (Detail = pacote do plugin)
+    Referencer,             // idem, encontrado pelos referencers do conteúdo do plugin
+    CachedPackage,          // hit reaproveitado do cache por pacote (Subject = pacote)
+    SourceFile,             // Build.cs / #include (Subject = arquivo, Detail = módulo ou include)
+    ConfigFile,             // .ini (Subject = arquivo, Detail = linha)
+    LoadedModule,           // módulo carregado no editor (Subject = módulo)
+    Dependency,             // dependência de um plugin usado (Subject = plugin dependente)
+};
+
+struct FPluginEvidence
+{
+    EPluginEvidenceKind Kind = EPluginEvidenceKind::AssetClass;
+
+    // Índices no pool de nomes do FPluginEvidenceIndex (INDEX_NONE = vazio)
+    int32 Subject = INDEX_NONE;
+    int32 Detail = INDEX_NONE;
+    int32 Tag = INDEX_NONE;
+};
+
+/*
+ * Proveniência dos hits do scan: no máximo MaxPerPlugin evidências por plugin
+ * (as primeiras encontradas) mais a contagem total. Os nomes ficam num pool
+ * de FNames deduplicado e as entradas guardam só índices, então a memória é
+ * limitada por NumPlugins * MaxPerPlugin, não pelo tamanho do projeto. O
+ * texto só é montado em Describe, quando a UI pede.
+ */
+class FPluginEvidenceIndex
+{
+public:
+    FPluginEvidenceIndex() = default;
+    FPluginEvidenceIndex(int32 NumPlugins, int32 InMaxPerPlugin);
+
+    // Conta o hit; true se ainda há vaga para o plugin (aí chame Add)
+    bool CountHit(int32 PluginIdx)
+    {
+        return ++TotalHits[PluginIdx] <= MaxPerPlugin;
+    }
+
+    void Add(int32 PluginIdx, EPluginEvidenceKind Kind, FName Subject, FName Detail = NAME_None, FName Tag = NAME_None);
+
+    // Soma o índice de um chunk paralelo (mesmos plugins), respeitando o limite
+    void Merge(const FPluginEvidenceIndex& Other);
+
+    int32 GetNumPlugins() const { return TotalHits.Num(); }
+    int32 GetMaxPerPlugin() const { return MaxPerPlugin; }
+
+    TConstArrayView<FPluginEvidence> Get(int32 PluginIdx) const
+    {
+        return TConstArrayView<FPluginEvidence>(Entries.GetData() + PluginIdx * MaxPerPlugin, NumEntries[PluginIdx]);
+    }
+
+    // Inclui os hits que passaram do limite
+    int32 GetTotalHits(int32 PluginIdx) const { return TotalHits[PluginIdx]; }
+
+    FName GetName(int32 PoolIdx) const { return PoolIdx == INDEX_NONE ? NAME_None : Pool[PoolIdx]; }
+
+    FText Describe(const FPluginEvidence& Evidence) const;
+
+    SIZE_T GetAllocatedSize() const;
+
+private:
+    int32 Intern(FName Name);
+
+    int32 MaxPerPlugin = 0;
+
+    TArray<FName>      Pool;
+    TMap<FName, int32> PoolIndex;
+
+    TArray<FPluginEvidence> Entries;        // MaxPerPlugin vagas por plugin
+    TArray<int32>           NumEntries;
+    TArray<int32>           TotalHits;
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "PluginOptimizerBenchmarkCommandlet.generated.h"
+
+/*
+ * Benchmark do scanner sobre registries sintéticos (não precisa de conteúdo
+ * nem de plugins reais; roda headless, inclusive no Linux):
+ *
+ *   UnrealEditor-Cmd <Projeto>.uproject -run=PluginOptimizerBenchmark -nullrhi
+ *       [-Sizes=10000,100000,1000000] [-Plugins=300] [-AssetsPerPlugin=20]
+ *       [-MountPath=/BenchPlugin{0}/] [-ClassTagRatio=0.3] [-InterfaceTagRatio=0.05]
+ *       [-DepsPerPackage=4] [-PluginContentRatio=0.02] [-Seed=1234]
+ *       [-Report=<arquivo.json>] [-Baseline=<arquivo.json>] [-UpdateBaseline] [-Tolerance=0.25]
+ *
+ * Cada tamanho roda a frio, com cache quente e com a passada de referencers;
+ * os três precisam concordar entre si e com o conjunto que o gerador anotou.
+ * -MountPath precisa de {0}. Cada execução grava no relatório todos os
+ * parâmetros do gerador e só é comparada com a entrada do baseline gerada
+ * com os mesmos. Retorna 1 em regressão contra o baseline (tempo, memória ou
+ * resultado), 2 em erro ou divergência entre os modos.
+ */
+UCLASS()
+class UPluginOptimizerBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UPluginOptimizerBenchmarkCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "Commandlets/Commandlet.h"
+#include "PluginOptimizerCommandlet.generated.h"
+
+/*
+ * Scan sem UI, para CI:
+ *
+ *   UnrealEditor-Cmd <Projeto>.uproject -run=PluginOptimizer -Report=<arquivo.json|.csv>
+ *       [-Baseline=<relatório.json>] [-UpdateBaseline]
+ *       [-ReferencePass=Referencers] [-NoCache] [-SkipSource] [-SkipConfig] [-SkipLoadedModules]
+ *       [-AssetRegistry=<AssetRegistry.bin>] [-TargetPlatform=<Win64|Linux|...>]
+ *       [-SaveSnapshot=<label>] [-DiffAgainst=<label|arquivo.snap>]
+ *
+ *   ... -run=PluginOptimizer -Projects=<A.uproject>[,<AssetRegistry.bin>]+<B.uproject>...
+ *       [-Report=<arquivo.json>] [-MaxParallel=<N>]
+ *
+ *   ... -run=PluginOptimizer -MapMatrix=<arquivo.csv|.json> [-AssetRegistry=<AssetRegistry.bin>]
+ *
+ * Os módulos removíveis por alvo seguem as regras do UBT para Shipping na
+ * plataforma de -TargetPlatform (padrão: a do editor).
+ *
+ * O CSV tem só plugin,status,reasons; os módulos removíveis por alvo vão para
+ * <arquivo>.targets.csv (target,plugin,modules) e os tempos por fase, só no JSON.
+ *
+ * Com -AssetRegistry o scan lê o registry serializado (cooked ou de
+ * desenvolvimento) em vez de coletar o do editor: não há espera pela coleta
+ * e a passada de módulos carregados é desligada.
+ *
+ * Com -Projects roda o batch offline (FPluginBatchScanner) e grava um único
+ * relatório com o resultado de cada projeto e os plugins sem uso em todos os
+ * projetos que os habilitam. Sem registry explícito, usa o cook mais recente.
+ *
+ * -SaveSnapshot grava o resultado como bitsets (ex.: label = branch ou commit)
+ * e -DiffAgainst compara com um snapshot gravado antes; o diff vai pro log e
+ * para o relatório JSON.
+ *
+ * -MapMatrix grava, para cada .umap de /Game, os plugins que o fecho das
+ * suas dependências alcança (matriz mapa x plugin), para tirar do chunk base
+ * o que só alguns mapas puxam.
+ *
+ * Retorna 1 quando aparecem candidatos que não estão no baseline, 2 em erro.
+ */
+UCLASS()
+class UPluginOptimizerCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UPluginOptimizerCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
@@ -4,6 +4,11 @@
 
 class FUICommandList;
 class UToolMenu;
+class SWindow;
+class SPluginOptimizerDialog;
+class FPluginScanTask;
+class FPluginUsageTracker;
+struct FPluginScanResult;
 
 class FPluginOptimizerModule : public IModuleInterface
 {
@@ -16,10 +21,25 @@ private:
     void AddMenuEntry(UToolMenu* Menu);
     void AddToolbarEntry(UToolMenu* Toolbar);
     void OnDetectUnusedPlugins();
+    void OnScanComplete(const FPluginScanResult& Result);
+    void CancelActiveScan();
+    void ShowResult(const FPluginScanResult& Result);
+
+    /* live tracking */
+    void SetLiveTracking(bool bEnable);
+    void OnTrackedUsageChanged();
     void ShowResultsPopup(const TArray<FString>& Candidates,
         int32 EnabledCount,
         int32 UsedCount);
 
 private:
     TSharedPtr<FUICommandList> PluginCommands;
+
+    /* scan em andamento + janela que mostra o progresso */
+    TSharedPtr<FPluginScanTask>        ActiveScan;
+    TWeakPtr<SWindow>                  ActiveWindow;
+    TWeakPtr<SPluginOptimizerDialog>   ActiveDialog;
+
+    /* opcional: mantém o uso atualizado pelos eventos do AssetRegistry */
+    TSharedPtr<FPluginUsageTracker>    UsageTracker;
 };
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Algo/BinarySearch.h"
+
+struct FPluginScanResult;
+
+/*
+ * Resultado de um scan reduzido a bitsets sobre uma tabela de nomes em ordem
+ * alfabética: o índice de um plugin não depende da ordem de GetEnabledPlugins,
+ * então snapshots de sessões, branches ou commits diferentes se comparam com
+ * operações por palavra em vez de hash de strings. Gravados em
+ * Saved/PluginOptimizer/Snapshots/<Label>.snap.
+ */
+class FPluginScanSnapshot
+{
+public:
+	static FPluginScanSnapshot FromResult(const FPluginScanResult& Result, const FString& Label);
+
+	static FString GetSnapshotPath(const FString& Label);
+
+	// Label do snapshot que o editor grava a cada scan (base do diff "desde o último scan")
+	static const TCHAR* LatestLabel;
+
+	bool Load(const FString& Path);
+	bool Save(const FString& Path) const;
+
+	// Mesmo conteúdo sobre outra tabela (ordenada); plugins ausentes ficam com bits 0
+	FPluginScanSnapshot Remap(const TArray<FString>& InPlugins) const;
+
+	int32 Find(const FString& Name) const { return Algo::BinarySearch(Plugins, Name); }
+
+	const TArray<FString>& GetPlugins() const { return Plugins; }
+	const TBitArray<>& GetEnabled() const { return Enabled; }
+	const TBitArray<>& GetUsed() const { return Used; }
+	const TBitArray<>& GetCandidates() const { return Candidates; }
+
+	FString   Label;
+	FDateTime Timestamp;
+
+private:
+	TArray<FString> Plugins;        // ordenado
+	TBitArray<>     Enabled;
+	TBitArray<>     Used;
+	TBitArray<>     Candidates;     // Enabled e não Used
+};
+
+/* O que mudou entre dois snapshots (Before -> After) */
+struct FPluginScanDiff
+{
+	TArray<FString> NewlyUsed;          // candidato antes, usado agora
+	TArray<FString> NewlyUnused;        // usado antes, candidato agora
+	TArray<FString> Added;              // habilitado só em After
+	TArray<FString> Removed;            // habilitado só em Before
+
+	static FPluginScanDiff Compute(const FPluginScanSnapshot& Before, const FPluginScanSnapshot& After);
+
+	bool IsEmpty() const { return NewlyUsed.IsEmpty() && NewlyUnused.IsEmpty() && Added.IsEmpty() && Removed.IsEmpty(); }
+
+	// Uma linha por mudança ("+used X", "-used Y"...), para log
+	FString ToString() const;
+};
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*
+ * Remoção de teste na sessão atual: confere quais pacotes de /Game deixariam
+ * de carregar, descarrega o conteúdo e os módulos sem UObject dos plugins
+ * (dependentes antes das dependências, fases de carga na ordem inversa),
+ * desmonta o conteúdo e mede a memória devolvida. Depois disso,
+ * Restore() volta tudo ao que era ou Commit() grava a desativação com
+ * FPluginDisableBatch. Destruir com o teste ativo chama Restore().
+ */
+class FPluginTrialUnload
+{
+public:
+	~FPluginTrialUnload();
+
+	// Recusa se a validação do FPluginDisableBatch falha ou se algum pacote
+	// de conteúdo carregado dos plugins tem mudanças não salvas
+	bool Begin(const TArray<FString>& PluginNames, FText& OutFailReason);
+
+	void Restore();
+
+	// Grava pelo .uproject; se falhar, restaura e devolve o motivo
+	bool Commit(FText& OutFailReason);
+
+	bool IsActive() const { return bActive; }
+
+	// UsedPhysical antes - depois (com GC e trim dos dois lados); pode ser negativo.
+	// Limite inferior: módulos em GetModulesKeptLoaded só saem no restart
+	int64 GetReclaimedBytes() const { return ReclaimedBytes; }
+
+	// Pacotes de /Game que importam um módulo dos plugins ou dependem do seu
+	// conteúdo: não carregariam depois da desativação
+	const TArray<FName>& GetBrokenPackages() const { return BrokenPackages; }
+
+	// Módulos com UObjects (pacote /Script carregado) ou sem suporte a unload
+	// dinâmico: continuam carregados até o restart
+	const TArray<FName>& GetModulesKeptLoaded() const { return KeptLoaded; }
+
+	const TArray<FString>& GetPlugins() const { return Plugins; }
+
+private:
+	struct FMount
+	{
+		FString RootPath;       // "/Plugin/"
+		FString ContentDir;
+	};
+
+	void ValidateDependents(const TSet<FName>& ScriptPackages, const TArray<FMount>& Mounts);
+
+	TArray<FString> Plugins;
+	TArray<FName>   Unloaded;           // na ordem do unload; o restore carrega do fim para o início
+	TArray<FMount>  Unmounted;
+	TArray<FName>   BrokenPackages;
+	TArray<FName>   KeptLoaded;
+	int64           ReclaimedBytes = 0;
+	bool            bActive = false;
+};
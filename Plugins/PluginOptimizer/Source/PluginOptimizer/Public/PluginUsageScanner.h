@@ -1,15 +1,284 @@
 #pragma once
 
 #include "CoreMinimal.h"
+#include "PluginEvidenceIndex.h"
+#include "ModuleDescriptor.h"
+
+#include <atomic>
+
+/* Por que um plugin foi considerado usado */
+enum class EPluginUsageReason : uint8
+{
+    None         = 0,
+    AssetClass   = 1 << 0,      // classe ou tag de classe de um asset de /Game (passada 1)
+    Referenced   = 1 << 1,      // dependência de um pacote de /Game (passada 2)
+    LoadedModule = 1 << 2,      // módulo carregado no editor (passada 3)
+    Dependency   = 1 << 3,      // dependência obrigatória de um plugin usado
+    SourceCode   = 1 << 4,      // Build.cs ou #include do Source/ do projeto
+    Config       = 1 << 5,      // "/Script/Module" nos .ini do projeto
+    PackageImport = 1 << 6,     // import "/Script/Module" no header de um pacote de /Game (passada profunda)
+};
+ENUM_CLASS_FLAGS(EPluginUsageReason)
+
+/* Fases do scan, na ordem em que rodam */
+enum class EPluginScanPhase : uint8
+{
+    WaitingForRegistry,
+    GameAssets,
+    PluginReferences,
+    PackageImports,
+    ProjectSource,
+    ProjectConfig,
+    LoadedModules,
+    Done
+};
+
+// O que conteúdo cozido, código ou .ini do projeto precisam (módulo carregado no editor não conta)
+constexpr EPluginUsageReason RuntimeUsageReasons = EPluginUsageReason::AssetClass
+    | EPluginUsageReason::Referenced | EPluginUsageReason::SourceCode | EPluginUsageReason::Config
+    | EPluginUsageReason::PackageImport;
+
+/* Alvos empacotados da análise por alvo (Shipping: módulos Developer* não entram) */
+enum class EPluginBuildTarget : uint8
+{
+    Game,
+    Client,
+    Server,
+    Num
+};
+
+const TCHAR* LexToString(EPluginScanPhase Phase);
+FString LexToString(EPluginUsageReason Reasons);
+const TCHAR* LexToString(EPluginBuildTarget Target);
+
+struct FPluginScanPhaseStats
+{
+    EPluginScanPhase Phase = EPluginScanPhase::Done;
+    double Seconds = 0.0;
+
+    // Memória física usada pelo processo: fim - início da fase
+    int64 MemoryDeltaBytes = 0;
+};
+
+/* Contadores de trabalho; somados por chunk e mesclados no fim de cada fase */
+struct FPluginScanCounters
+{
+    int64 PackagesVisited = 0;
+    int64 AssetsVisited = 0;
+    int64 TagLookups = 0;
+    int64 DependencyQueries = 0;    // GetDependencies / GetReferencers
+    int64 CachedPackages = 0;       // reaproveitados do cache por pacote
+    int64 SourceFiles = 0;
+    int64 ConfigFiles = 0;
+    int64 PackageHeaders = 0;       // headers lidos do disco na passada profunda
+
+    FPluginScanCounters& operator+=(const FPluginScanCounters& Other);
+};
+
+struct FPluginScanStats
+{
+    TArray<FPluginScanPhaseStats> Phases;       // na ordem em que rodaram
+    FPluginScanCounters Counters;
+
+    // Pico de memória física do processo ao fim do scan
+    uint64 PeakUsedPhysicalBytes = 0;
+
+    // Todos os alvos confirmados antes do fim: as passadas restantes foram
+    // puladas, então motivos e evidências ficam parciais
+    bool bStoppedEarly = false;
+
+    double GetTotalSeconds() const;
+
+    // Tabela de fases + contadores, para log e UI
+    FString ToString() const;
+};
+
+/* Módulo de plugin que entra num alvo empacotado */
+struct FPluginShippedModule
+{
+    FName Name;
+    EHostType::Type Type = EHostType::Runtime;
+    ELoadingPhase::Type Phase = ELoadingPhase::Default;
+};
+
+/* Plugin que leva módulos para o alvo sem que nada do projeto precise dele */
+struct FPluginStrippable
+{
+    FString Plugin;
+    TArray<FPluginShippedModule> Modules;
+};
+
+struct FPluginTargetReport
+{
+    EPluginBuildTarget Target = EPluginBuildTarget::Game;
+    FString Platform;                           // nome UBT (Win64, Linux...)
+    TArray<FPluginStrippable> Strippable;       // em ordem alfabética
+};
 
 struct FPluginScanResult
 {
     TArray<FString> EnabledPlugins;
     TArray<FString> UsedPlugins;
+
+    // Paralelo a EnabledPlugins
+    TArray<EPluginUsageReason> UsageReasons;
+
+    // Paralelo a EnabledPlugins: UsageReasons != None (inclusive por dependência).
+    // Para comparar entre execuções use FPluginScanSnapshot
+    TBitArray<> Used;
+
+    // Paralelo a EnabledPlugins: o que sai junto com cada candidato (sem ele
+    // mesmo, em ordem alfabética); vazio para plugins usados
+    TArray<TArray<FString>> RemovableGroups;
+
+    // Um por EPluginBuildTarget: plugins não usados em runtime (RuntimeUsageReasons,
+    // propagado pelas dependências) que ainda assim têm módulos no alvo
+    TArray<FPluginTargetReport> TargetReports;
+
+    FPluginScanStats Stats;
+
+    // Proveniência dos hits; nullptr se não coletada (MaxEvidencePerPlugin = 0).
+    // Compartilhado para a UI formatar sob demanda sem copiar o índice
+    TSharedPtr<const FPluginEvidenceIndex> Evidence;
+};
+
+/* Como a passada 2 detecta conteúdo de plugin referenciado por /Game */
+enum class EPluginReferencePass : uint8
+{
+    // Uma passada pelas dependências dos pacotes de /Game; custo ~ conteúdo do projeto
+    GameDependencies,
+
+    // Referencers de cada asset de cada plugin; custo ~ conteúdo dos plugins
+    PluginReferencers
+};
+
+struct FPluginScanOptions
+{
+    EPluginReferencePass ReferencePass = EPluginReferencePass::GameDependencies;
+
+    // Reaproveita os hits de pacotes não modificados desde o último scan
+    bool bUseCache = true;
+
+    // Vazio = Saved/PluginOptimizer/ScanCache.bin
+    FString CachePath;
+
+    // Raiz de Source/ e Config/ do projeto; vazio = projeto aberto (batch usa outros)
+    FString ProjectDir;
+
+    // Build.cs e #include do Source/ do projeto contam como uso
+    bool bScanSource = true;
+
+    // "/Script/Module" em seções e valores dos .ini do projeto conta como uso
+    bool bScanConfig = true;
+
+    // Passada 3: módulo carregado no editor conta como uso
+    bool bCheckLoadedModules = true;
+
+    // Passada profunda: lê a tabela de imports dos .uasset/.umap de /Game (sem
+    // carregar) e conta cada import "/Script/Module". Custa I/O por pacote;
+    // com o cache, só pacotes novos ou modificados são lidos. Actors externos
+    // são sempre lidos, mesmo com bLightweightExternalActors
+    bool bScanPackageImports = false;
+
+    // Evidências guardadas por plugin (o total de hits é sempre contado); 0 desliga
+    int32 MaxEvidencePerPlugin = 8;
+
+    // Assets por lote ao enumerar /Game e o conteúdo dos plugins: limita os
+    // FAssetData em memória ao mesmo tempo. Nome, flag de actor externo e
+    // entrada de cache por pacote continuam crescendo com o projeto
+    int32 AssetBatchSize = 16384;
+
+    // Pacotes de actors externos (World Partition): só a classe na passada 1,
+    // sem tags nem cache por pacote. A passada 2 continua vendo as dependências
+    bool bLightweightExternalActors = true;
+
+    // Plataforma UBT (Win64, Linux, Android...) dos relatórios por alvo: filtra
+    // módulos e plugins pelas listas de plataforma do descritor. Vazio = a do editor
+    FString TargetPlatform;
+};
+
+/* Plugins que cada mapa de /Game puxa (fecho transitivo das dependências de pacote) */
+struct FPluginMapReachability
+{
+    TArray<FString> Plugins;            // habilitados, na ordem de FPluginScanResult::EnabledPlugins
+    TArray<FName> Maps;                 // pacotes .umap, em ordem alfabética
+
+    // Paralelo a Maps, bits paralelos a Plugins: conteúdo ou módulo alcançado
+    // a partir do mapa, mais as dependências obrigatórias desses plugins
+    TArray<TBitArray<>> Reached;
+
+    int32 NumPackages = 0;              // pacotes distintos nos fechos de todos os mapas
+    int32 NumComponents = 0;            // componentes fortemente conexos do grafo
+    int32 NumDistinctSets = 0;          // conjuntos de plugins distintos guardados
+    int64 DependencyQueries = 0;
+    double Seconds = 0.0;
+
+    // Quantos mapas alcançam o plugin (0 = pode ficar fora de qualquer chunk de mapa)
+    int32 GetNumMapsReaching(int32 PluginIdx) const;
+};
+
+struct FPluginScanProgress
+{
+    EPluginScanPhase Phase = EPluginScanPhase::WaitingForRegistry;
+
+    // 0..1 dentro da fase atual; < 0 quando a fase nao tem total conhecido
+    float Fraction = -1.f;
+
+    FText GetPhaseText() const;
+};
+
+DECLARE_DELEGATE_OneParam(FOnPluginScanProgress, const FPluginScanProgress&);
+DECLARE_DELEGATE_OneParam(FOnPluginScanComplete, const FPluginScanResult&);
+
+/* Handle de um scan assincrono (ver FPluginUsageScanner::ScanAsync) */
+class FPluginScanTask
+{
+public:
+    // Pede o cancelamento; o callback de conclusao nao sera mais chamado
+    void Cancel() { bCancelled = true; }
+
+    bool IsCancelled() const { return bCancelled; }
+    bool IsFinished() const { return bFinished; }
+
+private:
+    friend struct FPluginUsageScanner;
+
+    std::atomic<bool> bCancelled{ false };
+    std::atomic<bool> bFinished{ false };
 };
 
 struct FPluginUsageScanner
 {
-    // Performs the scan and fills OutResult (runs entirely in editor thread)
-    static void Scan(FPluginScanResult& OutResult);
+    // Performs the scan and fills OutResult (blocks the calling thread)
+    static void Scan(FPluginScanResult& OutResult,
+        const FPluginScanOptions& Options = FPluginScanOptions());
+
+    // Runs the registry wait and all passes on background tasks.
+    // Must be called from the game thread; both delegates fire on the game thread
+    // and OnComplete is skipped if the task gets cancelled.
+    static TSharedRef<FPluginScanTask> ScanAsync(FOnPluginScanProgress OnProgress,
+        FOnPluginScanComplete OnComplete,
+        const FPluginScanOptions& Options = FPluginScanOptions());
+
+    // Offline: classifica um AssetRegistry.bin serializado (cooked ou de
+    // desenvolvimento) em vez do registry do editor; nada é coletado nem
+    // carregado além do arquivo. Loaded modules não se aplica e é ignorado.
+    // False se o arquivo não pôde ser lido.
+    static bool ScanRegistryFile(const FString& RegistryPath, FPluginScanResult& OutResult,
+        const FPluginScanOptions& Options = FPluginScanOptions());
+
+    // "PluginNames são usados?": só eles e quem depende deles são resolvidos, e
+    // o scan para assim que cada um tem a primeira referência que o confirma.
+    // OutResult cobre esse subconjunto (nomes desconhecidos ficam de fora); o
+    // cache por pacote não é lido nem gravado.
+    static void QueryPlugins(const TArray<FString>& PluginNames, FPluginScanResult& OutResult,
+        const FPluginScanOptions& Options = FPluginScanOptions());
+
+    // Matriz mapa x plugin para decidir chunks: cada pacote alcançado é
+    // consultado uma vez e o conjunto de plugins de cada componente do grafo
+    // é calculado uma vez, compartilhado por todos os mapas que passam por
+    // ele. RegistryPath vazio = registry do editor; senão um AssetRegistry.bin
+    // (false se não pôde ser lido).
+    static bool ScanMapReachability(FPluginMapReachability& OutResult, const FString& RegistryPath = FString(),
+        const FPluginScanOptions& Options = FPluginScanOptions());
 };
@@ -3,6 +3,17 @@
 #include "CoreMinimal.h"
 #include "Widgets/SCompoundWidget.h"
 #include "Widgets/Views/SListView.h"
+#include "PluginStartupProfile.h"
+#include "PluginDiskSizeEstimator.h"
+
+struct FPluginScanProgress;
+struct FPluginScanStats;
+struct FPluginScanResult;
+struct FPluginScanDiff;
+class FPluginEvidenceIndex;
+enum class EPluginUsageReason : uint8;
+
+DECLARE_DELEGATE_OneParam(FOnPluginOptimizerToggle, bool);
 
 /* ------------------------------------------------------------------ */
 /*  Janela principal do Plugin Optimizer                            */
@@ -14,19 +25,42 @@ public:
 		SLATE_ARGUMENT(TArray<FString>, Candidates)
 		SLATE_ARGUMENT(int32, EnabledCount)
 		SLATE_ARGUMENT(int32, UsedCount)
+		SLATE_ARGUMENT(bool, IsScanning)        // abre mostrando o progresso do scan
+		SLATE_EVENT(FSimpleDelegate, OnCancelScan)
+		SLATE_ARGUMENT(bool, LiveTracking)
+		SLATE_EVENT(FOnPluginOptimizerToggle, OnLiveTrackingChanged)
 	SLATE_END_ARGS()
 
 	void Construct(const FArguments& InArgs);
 
+	/* ---------- scan assncrono ------------ */
+	void SetScanProgress(const FPluginScanProgress& Progress);
+	void SetScanResult(const TArray<FString>& Candidates, int32 EnabledCount, int32 UsedCount,
+		const TMap<FString, TArray<FString>>& RemovableWith);
+	void SetScanStats(const FPluginScanStats& Stats);
+	void SetUsedPlugins(const FPluginScanResult& Result);
+	void SetScanDiff(const FPluginScanDiff& Diff, const FDateTime& PreviousScan);
+
+	/* ---------- perfil de startup ---------- */
+	void SetStartupCosts(const TMap<FString, FPluginStartupCost>& Costs);
+
+	/* ---------- tamanho em disco ----------- */
+	void SetDiskSizes(const TMap<FString, FPluginDiskSize>& Sizes);
+
 private:
 	/* ---------- gerao de linhas ---------- */
 	TSharedRef<ITableRow> OnGenerateRow(TSharedPtr<FString> Item,
 		const TSharedRef<STableViewBase>& OwnerTable);
+	TSharedRef<ITableRow> GenerateUsedRow(TSharedPtr<FString> Item,
+		const TSharedRef<STableViewBase>& OwnerTable);
+	FText GetEvidenceTip(const FString& PluginName) const;
 
 	/* ---------- botes do topo ------------- */
 	FReply OnSelectClicked();
 	FReply OnSelectAllClicked();
 	FReply OnDisableSelectedClicked();
+	FReply OnTrialSelectedClicked();
+	FReply OnCancelScanClicked();
 
 	/* ---------- checkbox linhas ------------ */
 	void   OnCheckboxChanged(ECheckBoxState State, TSharedPtr<FString> Item);
@@ -34,14 +68,51 @@ private:
 
 	/* ---------- lgica --------------------- */
 	bool DisableOne(const FString& PluginName);
-	void DisableMultiple(const TArray<FString>& ToDisable);
-	void ShowRestartPopup();                 // << NOVO
+	bool DisableMultiple(const TArray<FString>& ToDisable);
+	TArray<FString> GetSelectedWithGroups() const;
+	void RemoveDisabled(const TArray<FString>& Disabled);
+	bool ShowTrialPopup(const class FPluginTrialUnload& Trial);
+	void ShowRestartPopup(int32 NumDisabled);
 	void RefreshHeader();
+	void SetShowUsed(bool bShow);
+
+	/* ordenao dos candidatos pelo que desativar economiza (plugin + grupo) */
+	enum class ECandidateSort : uint8 { Name, StartupTime, StartupMemory, DiskSize, Num };
+	FPluginStartupCost GetSavings(const FString& PluginName) const;
+	FPluginDiskSize GetDiskSavings(const FString& PluginName) const;
+	void ApplySort();
+	FReply OnSortClicked();
 
 	/* ---------- dados ---------------------- */
 	TArray<TSharedPtr<FString>> Items;
 	TSet<FString>               Selected;
+	TMap<FString, TArray<FString>> RemovableWith;      // candidato -> o que sai junto
 	bool                        bSelectMode = false;
+	bool                        bShowUsed = false;      // lista os usados (com o porqu)
+	ECandidateSort              SortMode = ECandidateSort::Name;
+	TMap<FString, FPluginStartupCost> StartupCosts;     // vazio = sem perfil ainda
+	TMap<FString, FPluginDiskSize> DiskSizes;           // vazio = estimativa ainda rodando
+	bool                        bScanning = false;
+	bool                        bLiveTracking = false;
+	FOnPluginOptimizerToggle    OnLiveTrackingChanged;
+
+	/* usados: motivo + evidncias; o tooltip s  montado ao passar o mouse */
+	struct FUsedInfo
+	{
+		int32 PluginIdx = INDEX_NONE;       // ndice em FPluginScanResult::EnabledPlugins
+		EPluginUsageReason Reasons{};
+	};
+	TArray<TSharedPtr<FString>>              UsedItems;
+	TMap<FString, FUsedInfo>                 UsedInfo;
+	TSharedPtr<const FPluginEvidenceIndex>   Evidence;
+	mutable TMap<FString, FText>             EvidenceTips;
+
+	FText            ScanPhaseText;
+	TOptional<float> ScanFraction;          // unset = barra indeterminada
+	FText            StatsText;             // vazio = painel escondido
+	FText            DiffText;              // mudanas desde o scan anterior; vazio = escondido
+	FText            DiffTip;
+	FSimpleDelegate  OnCancelScan;
 
 	int32 EnabledCnt = 0;
 	int32 UsedCnt = 0;
@@ -51,4 +122,5 @@ private:
 	TSharedPtr<STextBlock>                     HeaderText;
 	TSharedPtr<SButton>                        SelectAllBtn;
 	TSharedPtr<SButton>                        DisableSelectedBtn;
+	TSharedPtr<SButton>                        TrialSelectedBtn;
 };
@@ -0,0 +1,18 @@
+using UnrealBuildTool;
+
+public class PluginOptimizerProfiler : ModuleRules
+{
+    public PluginOptimizerProfiler(ReadOnlyTargetRules Target) : base(Target)
+    {
+        PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+
+        /* Carrega cedo (PostConfigInit) para ver os módulos dos outros plugins
+           subindo: só depende do que já está de pé nessa fase. */
+        PrivateDependencyModuleNames.AddRange(new[]
+        {
+            "Core",
+            "Projects",        // IPluginManager: módulo -> plugin
+            "Json"             // perfil salvo em Saved/
+        });
+    }
+}
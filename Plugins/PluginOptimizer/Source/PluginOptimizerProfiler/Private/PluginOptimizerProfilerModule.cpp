@@ -0,0 +1,136 @@
+#include "PluginStartupProfile.h"
+
+#include "Modules/ModuleManager.h"
+#include "Interfaces/IPluginManager.h"
+#include "Misc/CoreDelegates.h"
+#include "HAL/PlatformTime.h"
+#include "HAL/PlatformMemory.h"
+
+/*
+ * Mede o StartupModule de cada módulo: OnProcessLoadedObjectsCallback dispara
+ * logo antes dele (DLL já carregada, UObjects registrados) e OnModulesChanged
+ * logo depois. Loads aninhados ficam numa pilha e são descontados do módulo
+ * de fora; o trabalho do engine entre dois loads não vai para ninguém. O
+ * carregamento da DLL e o registro de UObjects ficam de fora, e a memória é a
+ * do processo inteiro: os números são aproximados. No fim da inicialização
+ * agrega por plugin e grava o perfil para a UI da próxima sessão.
+ */
+class FPluginOptimizerProfilerModule : public IModuleInterface
+{
+public:
+	virtual void StartupModule() override
+	{
+		if (IsRunningCommandlet())
+			return;
+
+		TArray<FModuleStatus> Statuses;
+		FModuleManager::Get().QueryModules(Statuses);
+		for (const FModuleStatus& S : Statuses)
+			NumUnmeasured += S.bIsLoaded ? 1 : 0;
+
+		FModuleManager::Get().OnProcessLoadedObjectsCallback().AddRaw(this, &FPluginOptimizerProfilerModule::OnModuleStarting);
+		FModuleManager::Get().OnModulesChanged().AddRaw(this, &FPluginOptimizerProfilerModule::OnModulesChanged);
+		FCoreDelegates::OnFEngineLoopInitComplete.AddRaw(this, &FPluginOptimizerProfilerModule::OnInitComplete);
+	}
+
+	virtual void ShutdownModule() override
+	{
+		StopRecording();
+	}
+
+private:
+	struct FModuleLoad
+	{
+		FName  Module;
+		double Seconds;
+		int64  MemoryBytes;
+	};
+
+	// StartupModule em andamento; Nested* = o que os loads de dentro já levaram
+	struct FOpenLoad
+	{
+		FName  Module;
+		double Start;
+		int64  StartMemory;
+		double NestedSeconds = 0.0;
+		int64  NestedMemory = 0;
+	};
+
+	void OnModuleStarting(FName ModuleName, bool)
+	{
+		if (!ModuleName.IsNone())
+			Open.Add({ ModuleName, FPlatformTime::Seconds(), int64(FPlatformMemory::GetStats().UsedPhysical) });
+	}
+
+	void OnModulesChanged(FName ModuleName, EModuleChangeReason Reason)
+	{
+		if (Reason != EModuleChangeReason::ModuleLoaded)
+			return;
+
+		// sem início registrado não há o que medir
+		const int32 Idx = Open.FindLastByPredicate([ModuleName](const FOpenLoad& L) { return L.Module == ModuleName; });
+		if (Idx == INDEX_NONE)
+		{
+			++NumUnmeasured;
+			return;
+		}
+
+		// o que ficou acima nunca terminou (load que falhou): o tempo segue no de fora
+		const FOpenLoad Load = Open[Idx];
+		Open.SetNum(Idx);
+
+		const double Elapsed = FPlatformTime::Seconds() - Load.Start;
+		const int64 MemoryDelta = int64(FPlatformMemory::GetStats().UsedPhysical) - Load.StartMemory;
+		if (Open.Num())
+		{
+			Open.Last().NestedSeconds += Elapsed;
+			Open.Last().NestedMemory += MemoryDelta;
+		}
+
+		// memória do processo oscila (GC, trim do allocator): nunca negativa
+		Loads.Add({ ModuleName, FMath::Max(0.0, Elapsed - Load.NestedSeconds), FMath::Max<int64>(0, MemoryDelta - Load.NestedMemory) });
+	}
+
+	void OnInitComplete()
+	{
+		StopRecording();
+
+		TMap<FName, FString> ModuleToPlugin;
+		for (const TSharedRef<IPlugin>& P : IPluginManager::Get().GetEnabledPlugins())
+		{
+			for (const FModuleDescriptor& M : P->GetDescriptor().Modules)
+				ModuleToPlugin.Add(M.Name, P->GetName());
+		}
+
+		FPluginStartupProfile Profile;
+		Profile.NumUnmeasuredModules = NumUnmeasured;
+		for (const FModuleLoad& Load : Loads)
+		{
+			const FString* Plugin = ModuleToPlugin.Find(Load.Module);
+			if (!Plugin)
+				continue;
+
+			FPluginStartupCost& Cost = Profile.Plugins.FindOrAdd(*Plugin);
+			Cost.Milliseconds += Load.Seconds * 1000.0;
+			Cost.MemoryBytes += Load.MemoryBytes;
+			++Cost.NumModules;
+		}
+		Profile.Save();
+
+		Loads.Empty();
+		Open.Empty();
+	}
+
+	void StopRecording()
+	{
+		FModuleManager::Get().OnProcessLoadedObjectsCallback().RemoveAll(this);
+		FModuleManager::Get().OnModulesChanged().RemoveAll(this);
+		FCoreDelegates::OnFEngineLoopInitComplete.RemoveAll(this);
+	}
+
+	TArray<FModuleLoad> Loads;
+	TArray<FOpenLoad> Open;         // pilha de loads aninhados
+	int32 NumUnmeasured = 0;
+};
+
+IMPLEMENT_MODULE(FPluginOptimizerProfilerModule, PluginOptimizerProfiler)
@@ -0,0 +1,70 @@
+#include "PluginStartupProfile.h"
+
+#include "Dom/JsonObject.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+FString FPluginStartupProfile::GetDefaultPath()
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("PluginOptimizer"), TEXT("StartupProfile.json"));
+}
+
+bool FPluginStartupProfile::Load(const FString& Path)
+{
+	Plugins.Reset();
+
+	FString Text;
+	if (!FFileHelper::LoadFileToString(Text, *Path))
+		return false;
+
+	TSharedPtr<FJsonObject> Root;
+	if (!FJsonSerializer::Deserialize(TJsonReaderFactory<>::Create(Text), Root) || !Root.IsValid())
+		return false;
+
+	Root->TryGetNumberField(TEXT("unmeasuredModules"), NumUnmeasuredModules);
+
+	const TArray<TSharedPtr<FJsonValue>>* Entries = nullptr;
+	if (!Root->TryGetArrayField(TEXT("plugins"), Entries))
+		return false;
+
+	for (const TSharedPtr<FJsonValue>& Value : *Entries)
+	{
+		const TSharedPtr<FJsonObject>* Entry = nullptr;
+		FString Name;
+		if (!Value->TryGetObject(Entry) || !(*Entry)->TryGetStringField(TEXT("name"), Name))
+			continue;
+
+		FPluginStartupCost& Cost = Plugins.Add(Name);
+		(*Entry)->TryGetNumberField(TEXT("ms"), Cost.Milliseconds);
+		(*Entry)->TryGetNumberField(TEXT("memoryBytes"), Cost.MemoryBytes);
+		(*Entry)->TryGetNumberField(TEXT("modules"), Cost.NumModules);
+
+		// perfis antigos somavam deltas negativos
+		Cost.MemoryBytes = FMath::Max<int64>(0, Cost.MemoryBytes);
+	}
+	return true;
+}
+
+bool FPluginStartupProfile::Save(const FString& Path) const
+{
+	TArray<TSharedPtr<FJsonValue>> Entries;
+	for (const TPair<FString, FPluginStartupCost>& Pair : Plugins)
+	{
+		TSharedRef<FJsonObject> Entry = MakeShared<FJsonObject>();
+		Entry->SetStringField(TEXT("name"), Pair.Key);
+		Entry->SetNumberField(TEXT("ms"), Pair.Value.Milliseconds);
+		Entry->SetNumberField(TEXT("memoryBytes"), double(Pair.Value.MemoryBytes));
+		Entry->SetNumberField(TEXT("modules"), Pair.Value.NumModules);
+		Entries.Add(MakeShared<FJsonValueObject>(Entry));
+	}
+
+	TSharedRef<FJsonObject> Root = MakeShared<FJsonObject>();
+	Root->SetNumberField(TEXT("unmeasuredModules"), NumUnmeasuredModules);
+	Root->SetArrayField(TEXT("plugins"), Entries);
+
+	FString Out;
+	FJsonSerializer::Serialize(Root, TJsonWriterFactory<>::Create(&Out));
+	return FFileHelper::SaveStringToFile(Out, *Path);
+}
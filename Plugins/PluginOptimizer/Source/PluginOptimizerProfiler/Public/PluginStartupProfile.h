@@ -0,0 +1,33 @@
+#pragma once
+
+#include "CoreMinimal.h"
+
+/*
+ * Custo aproximado de subir os módulos de um plugin, medido no startup do
+ * editor: StartupModule de cada um, sem os loads aninhados nem o carregamento
+ * da DLL
+ */
+struct FPluginStartupCost
+{
+    double Milliseconds = 0.0;
+    int64  MemoryBytes = 0;         // memória física do processo durante o StartupModule; >= 0
+    int32  NumModules = 0;
+};
+
+/*
+ * Perfil de startup gravado por FPluginOptimizerProfilerModule ao fim da
+ * inicialização do editor (Saved/PluginOptimizer/StartupProfile.json) e lido
+ * pela UI na sessão seguinte.
+ */
+struct PLUGINOPTIMIZERPROFILER_API FPluginStartupProfile
+{
+    TMap<FString, FPluginStartupCost> Plugins;
+
+    // Módulos que já estavam carregados quando o profiler subiu (não medidos)
+    int32 NumUnmeasuredModules = 0;
+
+    static FString GetDefaultPath();
+
+    bool Load(const FString& Path = GetDefaultPath());
+    bool Save(const FString& Path = GetDefaultPath()) const;
+};